@@ -13,7 +13,7 @@ os.chdir(os.path.dirname(__file__))
 for file in glob.glob("*.delta"):
     extension = ".out" if platform.system() != "Windows" else ".exe"
     output = os.path.splitext(file)[0] + extension
-    exit_status = subprocess.call([delta_path, file, "-o", output])
+    exit_status = subprocess.call([delta_path, file, "-o", output, "-no-cache"])
     if exit_status != 0:
         sys.exit(1)
 
@@ -0,0 +1,25 @@
+#include "compilation-context.h"
+
+using namespace delta;
+
+bool CompilationContext::multithreaded = false;
+
+CompilationContext& CompilationContext::get() {
+    // Intentionally leaked: if the context were destroyed by exit(), e.g. when a thread calls ABORT, the arenas would be
+    // freed while other threads may still be using the nodes in them.
+    static auto* context = new CompilationContext();
+    return *context;
+}
+
+void* CompilationContext::allocate(size_t size, size_t alignment) {
+    // Each thread gets its own arena so that allocation doesn't need to be synchronized.
+    thread_local llvm::BumpPtrAllocator* arena = nullptr;
+
+    if (!arena) {
+        std::lock_guard<std::mutex> lock(mutex);
+        arenas.push_back(std::make_unique<llvm::BumpPtrAllocator>());
+        arena = arenas.back().get();
+    }
+
+    return arena->Allocate(size, alignment);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#pragma warning(push, 0)
+#include <llvm/Support/Allocator.h>
+#pragma warning(pop)
+#include "../support/statistics.h"
+
+namespace delta {
+
+/// Owns the memory of the AST, Decl, and Type nodes created during a compilation. Nodes are
+/// bump-allocated from per-thread arenas, which makes allocating them cheap and keeps nodes created
+/// together close to each other in memory. Nodes are never freed: the arenas live until the process
+/// exits, and their memory is reclaimed by the operating system.
+class CompilationContext {
+public:
+    static CompilationContext& get();
+    /// Allocates memory from the arena of the calling thread.
+    void* allocate(size_t size, size_t alignment);
+    /// True while function bodies are typechecked in parallel. Only then do shared data structures such as symbol
+    /// tables and the type interning table need to be locked. Must only be changed while no other threads are running.
+    static bool isMultithreaded() { return multithreaded; }
+    static void setMultithreaded(bool value) { multithreaded = value; }
+
+private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<llvm::BumpPtrAllocator>> arenas;
+    static bool multithreaded;
+};
+
+/// Returns a lock of the mutex that is only locked while CompilationContext::isMultithreaded() is true.
+template<typename Mutex>
+std::unique_lock<Mutex> lockIfMultithreaded(Mutex& mutex) {
+    std::unique_lock<Mutex> lock(mutex, std::defer_lock);
+    if (CompilationContext::isMultithreaded()) lock.lock();
+    return lock;
+}
+
+/// Base class for node types whose instances are allocated in the CompilationContext arena when
+/// created with `new`. Deleting such nodes is a no-op.
+class ArenaAllocated {
+public:
+    static void* operator new(size_t size) {
+        addToStatistic(Statistic::NodesAllocated);
+        return CompilationContext::get().allocate(size, alignof(std::max_align_t));
+    }
+    static void operator delete(void*) {}
+};
+
+} // namespace delta
@@ -4,6 +4,7 @@
 #include <llvm/Support/ErrorHandling.h>
 #pragma warning(pop)
 #include "mangle.h"
+#include "../support/statistics.h"
 #include "../support/utility.h"
 
 using namespace delta;
@@ -19,10 +20,12 @@ FunctionDecl* FunctionTemplate::instantiate(const llvm::StringMap<Type>& generic
     ASSERT(!genericParams.empty() && !genericArgs.empty());
 
     auto orderedGenericArgs = map(genericParams, [&](auto& genericParam) { return genericArgs.find(genericParam.getName())->second; });
+    auto lock = lockIfMultithreaded(instantiationsMutex);
 
     auto it = instantiations.find(orderedGenericArgs);
     if (it != instantiations.end()) return it->second;
     auto instantiation = getFunctionDecl()->instantiate(genericArgs, orderedGenericArgs);
+    addToStatistic(Statistic::TemplatesInstantiated);
     return instantiations.emplace(std::move(orderedGenericArgs), instantiation).first->second;
 }
 
@@ -136,11 +139,32 @@ bool TypeDecl::isCopyable() const {
 }
 
 void TypeDecl::addField(FieldDecl&& field) {
+    auto index = static_cast<unsigned>(fields.size());
+    fieldIndices.try_emplace(field.getName(), index);
+    fieldIndices.try_emplace(field.getQualifiedName(), index);
     fields.emplace_back(std::move(field));
 }
 
 void TypeDecl::addMethod(Decl* decl) {
     methods.push_back(decl);
+
+    if (auto* functionDecl = llvm::dyn_cast<FunctionDecl>(decl)) {
+        methodsByName[functionDecl->getName()].push_back(decl);
+    } else if (auto* functionTemplate = llvm::dyn_cast<FunctionTemplate>(decl)) {
+        methodsByName[functionTemplate->getQualifiedName()].push_back(decl);
+    }
+}
+
+llvm::ArrayRef<Decl*> TypeDecl::findMethods(llvm::StringRef name) const {
+    auto it = methodsByName.find(name);
+    if (it == methodsByName.end()) return {};
+    return it->second;
+}
+
+FieldDecl* TypeDecl::findField(llvm::StringRef name) {
+    auto it = fieldIndices.find(name);
+    if (it == fieldIndices.end()) return nullptr;
+    return &fields[it->second];
 }
 
 DeinitDecl* TypeDecl::getDeinitializer() const {
@@ -165,12 +189,9 @@ Type TypeDecl::getTypeForPassing() const {
 }
 
 unsigned TypeDecl::getFieldIndex(llvm::StringRef fieldName) const {
-    for (auto p : llvm::enumerate(fields)) {
-        if (p.value().getName() == fieldName) {
-            return static_cast<unsigned>(p.index());
-        }
-    }
-    llvm_unreachable("unknown field");
+    auto it = fieldIndices.find(fieldName);
+    if (it == fieldIndices.end()) llvm_unreachable("unknown field");
+    return it->second;
 }
 
 TypeDecl* TypeTemplate::instantiate(const llvm::StringMap<Type>& genericArgs) {
@@ -178,11 +199,13 @@ TypeDecl* TypeTemplate::instantiate(const llvm::StringMap<Type>& genericArgs) {
 
     auto orderedGenericArgs = map(getGenericParams(),
                                   [&](const GenericParamDecl& genericParam) { return genericArgs.find(genericParam.getName())->second; });
+    auto lock = lockIfMultithreaded(instantiationsMutex);
 
     auto it = instantiations.find(orderedGenericArgs);
     if (it != instantiations.end()) return it->second;
 
     auto instantiation = llvm::cast<TypeDecl>(getTypeDecl()->instantiate(genericArgs, orderedGenericArgs));
+    addToStatistic(Statistic::TemplatesInstantiated);
     return instantiations.emplace(std::move(orderedGenericArgs), instantiation).first->second;
 }
 
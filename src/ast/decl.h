@@ -1,13 +1,16 @@
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #pragma warning(push, 0)
 #include <llvm/ADT/Optional.h>
 #include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringMap.h>
 #include <llvm/Support/Casting.h>
 #pragma warning(pop)
+#include "compilation-context.h"
 #include "expr.h"
 #include "location.h"
 #include "stmt.h"
@@ -78,7 +81,7 @@ inline llvm::raw_ostream& operator<<(llvm::raw_ostream& stream, AccessLevel acce
     llvm_unreachable("all cases handled");
 }
 
-class Decl {
+class Decl : public ArenaAllocated {
 public:
     virtual ~Decl() = 0;
 
@@ -299,6 +302,7 @@ private:
     std::vector<GenericParamDecl> genericParams;
     FunctionDecl* functionDecl;
     std::unordered_map<std::vector<Type>, FunctionDecl*> instantiations;
+    std::mutex instantiationsMutex;
 };
 
 enum class TypeTag { Struct, Interface, Union, Enum };
@@ -324,6 +328,10 @@ public:
     void addField(FieldDecl&& field);
     void addMethod(Decl* decl);
     llvm::ArrayRef<Decl*> getMemberDecls() const { return methods; }
+    /// Returns the member functions with the given name, or the member function templates with the given qualified name.
+    llvm::ArrayRef<Decl*> findMethods(llvm::StringRef name) const;
+    /// Returns the field with the given name or qualified name, or null if there's no such field.
+    FieldDecl* findField(llvm::StringRef name);
     DeinitDecl* getDeinitializer() const;
     Type getType(Mutability mutability = Mutability::Mutable) const;
     Type getTypeForPassing() const;
@@ -346,6 +354,9 @@ private:
     std::vector<Type> interfaces;
     std::vector<FieldDecl> fields;
     std::vector<Decl*> methods;
+    /// Indices of the fields, keyed on both the name and the qualified name of each field.
+    llvm::StringMap<unsigned> fieldIndices;
+    llvm::StringMap<llvm::SmallVector<Decl*, 1>> methodsByName;
     SourceLocation location;
     Module& module;
 };
@@ -367,6 +378,7 @@ private:
     std::vector<GenericParamDecl> genericParams;
     TypeDecl* typeDecl;
     std::unordered_map<std::vector<Type>, TypeDecl*> instantiations;
+    std::mutex instantiationsMutex;
 };
 
 class EnumCase : public VariableDecl {
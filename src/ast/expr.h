@@ -6,6 +6,7 @@
 #include <llvm/ADT/APSInt.h>
 #include <llvm/Support/Casting.h>
 #pragma warning(pop)
+#include "compilation-context.h"
 #include "location.h"
 #include "token.h"
 #include "type.h"
@@ -40,7 +41,7 @@ enum class ExprKind {
     IfExpr
 };
 
-class Expr {
+class Expr : public ArenaAllocated {
 public:
     virtual ~Expr() = 0;
 
@@ -343,7 +344,14 @@ public:
     const Expr* getIndexExpr() const { return getArgs()[0].getValue(); }
     Expr* getBaseExpr() { return getReceiver(); }
     Expr* getIndexExpr() { return getArgs()[0].getValue(); }
+    /// Returns true if the index is known to be within the bounds of the List being indexed, in which case the
+    /// subscript operator's bounds check is omitted.
+    bool isIndexInBounds() const { return indexInBounds; }
+    void setIndexInBounds() { indexInBounds = true; }
     static bool classof(const Expr* e) { return e->getKind() == ExprKind::SubscriptExpr; }
+
+private:
+    bool indexInBounds = false;
 };
 
 /// A postfix expression that unwraps an optional (nullable) value, yielding the value wrapped by
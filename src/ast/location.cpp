@@ -0,0 +1,102 @@
+#include "location.h"
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <vector>
+#pragma warning(push, 0)
+#include <llvm/Support/MemoryBuffer.h>
+#pragma warning(pop)
+#include "../support/utility.h"
+
+using namespace delta;
+
+namespace {
+
+struct SourceBuffer {
+    const llvm::MemoryBuffer* buffer;
+    uint32_t startOffset;
+    /// The offsets of the first characters of each line, relative to startOffset. Empty until computed.
+    std::vector<uint32_t> lineStartOffsets;
+};
+
+} // namespace
+
+// Locations are decoded from multiple threads during parallel code generation.
+static std::mutex sourceBuffersMutex;
+static std::vector<SourceBuffer> sourceBuffers;
+static uint32_t nextBufferOffset = 1;
+
+SourceLocation SourceManager::addBuffer(const llvm::MemoryBuffer& buffer) {
+    std::lock_guard<std::mutex> lock(sourceBuffersMutex);
+
+    // Reserve an extra offset for the end of the buffer, where the end-of-file token is located.
+    if (buffer.getBufferSize() >= std::numeric_limits<uint32_t>::max() - nextBufferOffset) {
+        ABORT("total size of source files exceeds 4 GiB");
+    }
+
+    SourceLocation location(nextBufferOffset);
+    sourceBuffers.push_back({ &buffer, nextBufferOffset, {} });
+    nextBufferOffset += uint32_t(buffer.getBufferSize()) + 1;
+    return location;
+}
+
+/// Returns null if the location is invalid or doesn't belong to any registered buffer.
+static SourceBuffer* findSourceBuffer(SourceLocation location) {
+    if (!location.isValid()) return nullptr;
+
+    auto it = std::upper_bound(sourceBuffers.begin(), sourceBuffers.end(), location.getOffset(),
+                               [](uint32_t offset, const SourceBuffer& buffer) { return offset < buffer.startOffset; });
+    if (it == sourceBuffers.begin()) return nullptr;
+    --it;
+
+    // The offset after the last character of a buffer is valid: it's the location of the end-of-file token.
+    if (location.getOffset() - it->startOffset > it->buffer->getBufferSize()) return nullptr;
+    return &*it;
+}
+
+DecodedSourceLocation SourceManager::decode(SourceLocation location) {
+    std::lock_guard<std::mutex> lock(sourceBuffersMutex);
+    auto* sourceBufferPointer = findSourceBuffer(location);
+    if (!sourceBufferPointer) return { "", 0, 0, {} };
+    auto& sourceBuffer = *sourceBufferPointer;
+    auto source = sourceBuffer.buffer->getBuffer();
+    auto& lineStartOffsets = sourceBuffer.lineStartOffsets;
+
+    if (lineStartOffsets.empty()) {
+        lineStartOffsets.push_back(0);
+
+        for (size_t i = 0; i < source.size(); ++i) {
+            if (source[i] == '\n') {
+                lineStartOffsets.push_back(uint32_t(i + 1));
+            }
+        }
+    }
+
+    uint32_t offset = location.getOffset() - sourceBuffer.startOffset;
+    auto lineStart = std::upper_bound(lineStartOffsets.begin(), lineStartOffsets.end(), offset) - 1;
+    auto lineContent = source.substr(*lineStart).take_until([](char ch) { return ch == '\n' || ch == '\r'; });
+    int line = int(lineStart - lineStartOffsets.begin()) + 1;
+    int column = int(offset - *lineStart) + 1;
+    return { sourceBuffer.buffer->getBufferIdentifier().data(), line, column, lineContent };
+}
+
+const char* SourceManager::getCharacterData(SourceLocation location) {
+    std::lock_guard<std::mutex> lock(sourceBuffersMutex);
+    auto* sourceBuffer = findSourceBuffer(location);
+    if (!sourceBuffer) return nullptr;
+    return sourceBuffer->buffer->getBufferStart() + (location.getOffset() - sourceBuffer->startOffset);
+}
+
+const char* SourceLocation::getFile() const {
+    std::lock_guard<std::mutex> lock(sourceBuffersMutex);
+    auto* sourceBuffer = findSourceBuffer(*this);
+    return sourceBuffer ? sourceBuffer->buffer->getBufferIdentifier().data() : nullptr;
+}
+
+int SourceLocation::getLine() const {
+    return SourceManager::decode(*this).line;
+}
+
+int SourceLocation::getColumn() const {
+    return SourceManager::decode(*this).column;
+}
@@ -1,20 +1,54 @@
 #pragma once
 
-#include <limits>
+#include <cstdint>
+#pragma warning(push, 0)
+#include <llvm/ADT/StringRef.h>
+#pragma warning(pop)
+
+namespace llvm {
+class MemoryBuffer;
+}
 
 namespace delta {
 
+/// A position in a source file, encoded as an offset into the concatenation of all source buffers
+/// registered with the SourceManager. The file, line, and column are computed from the offset only
+/// when they're needed, e.g. when printing a diagnostic.
 struct SourceLocation {
-    using IntegerType = short;
+    SourceLocation() : offset(0) {}
+    explicit SourceLocation(uint32_t offset) : offset(offset) {}
+    bool isValid() const { return offset != 0; }
+    uint32_t getOffset() const { return offset; }
+    SourceLocation getLocationWithOffset(int32_t offset) const { return SourceLocation(this->offset + offset); }
+    /// Returns the path of the file containing this location, or null if the location is invalid.
+    const char* getFile() const;
+    int getLine() const;
+    int getColumn() const;
+
+private:
+    /// Zero is reserved for invalid locations.
+    uint32_t offset;
+};
 
+/// The file, line, and column of a SourceLocation, and the contents of its line. For invalid locations,
+/// the file is empty and the line and column are zero.
+struct DecodedSourceLocation {
     const char* file;
-    IntegerType line;
-    IntegerType column;
+    int line;
+    int column;
+    llvm::StringRef lineContent;
+};
 
-    SourceLocation() : SourceLocation(nullptr, std::numeric_limits<IntegerType>::min(), std::numeric_limits<IntegerType>::min()) {}
-    SourceLocation(const char* file, IntegerType line, IntegerType column) : file(file), line(line), column(column) {}
-    SourceLocation nextColumn() const { return SourceLocation(file, line, column + 1); }
-    bool isValid() const { return line > 0 && column > 0; }
+/// Assigns each source buffer a range of SourceLocation offsets, and maps offsets back to files,
+/// lines, and columns using line tables that are built the first time a buffer's locations are decoded.
+class SourceManager {
+public:
+    /// Registers the given buffer, which must stay alive until the end of the compilation, and
+    /// returns the location of its first character.
+    static SourceLocation addBuffer(const llvm::MemoryBuffer& buffer);
+    static DecodedSourceLocation decode(SourceLocation location);
+    /// Returns a pointer to the source character at the given location, or null if the location is invalid.
+    static const char* getCharacterData(SourceLocation location);
 };
 
 } // namespace delta
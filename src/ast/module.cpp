@@ -1,10 +1,25 @@
 #include "module.h"
+#include <unordered_map>
 #include "mangle.h"
 
 using namespace delta;
 
 llvm::StringMap<Module*> Module::allImportedModules;
 
+std::vector<Scope>& SymbolTable::getThreadLocalScopes() const {
+    static thread_local std::unordered_map<const SymbolTable*, std::vector<Scope>> localScopes;
+    // Most lookups hit the same symbol table as the previous one, so avoid the hash table lookup in that case.
+    static thread_local const SymbolTable* cachedSymbolTable = nullptr;
+    static thread_local std::vector<Scope>* cachedLocalScopes = nullptr;
+
+    if (cachedSymbolTable != this) {
+        cachedLocalScopes = &localScopes[this];
+        cachedSymbolTable = this;
+    }
+
+    return *cachedLocalScopes;
+}
+
 std::vector<Module*> Module::getAllImportedModules() {
     return map(allImportedModules, [](auto& p) { return p.second; });
 }
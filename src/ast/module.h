@@ -1,5 +1,6 @@
 #pragma once
 
+#include <shared_mutex>
 #include <string>
 #include <vector>
 #pragma warning(push, 0)
@@ -8,6 +9,7 @@
 #include <llvm/ADT/StringMap.h>
 #include <llvm/ADT/StringRef.h>
 #pragma warning(pop)
+#include "compilation-context.h"
 #include "decl.h"
 
 namespace delta {
@@ -40,28 +42,74 @@ struct Scope {
     llvm::StringMap<std::vector<Decl*>> decls;
 };
 
+/// The decls found by a symbol table lookup. They're referenced in place, except while function bodies
+/// are typechecked in parallel, when the decls of the global scope are copied, since another thread may
+/// add to it (e.g. overloads of an instantiated method) while they're used.
+class LookupResult {
+public:
+    LookupResult() = default;
+    LookupResult(llvm::ArrayRef<Decl*> decls, bool copy) {
+        if (copy) {
+            copiedDecls.assign(decls.begin(), decls.end());
+            isCopy = true;
+        } else {
+            this->decls = decls;
+        }
+    }
+    llvm::ArrayRef<Decl*> get() const { return isCopy ? llvm::ArrayRef<Decl*>(copiedDecls) : decls; }
+    operator llvm::ArrayRef<Decl*>() const { return get(); }
+    Decl* const* begin() const { return get().begin(); }
+    Decl* const* end() const { return get().end(); }
+    size_t size() const { return get().size(); }
+    bool empty() const { return get().empty(); }
+    Decl* operator[](size_t index) const { return get()[index]; }
+
+private:
+    llvm::ArrayRef<Decl*> decls;
+    llvm::SmallVector<Decl*, 1> copiedDecls;
+    bool isCopy = false;
+};
+
+/// While function bodies are typechecked in parallel (see CompilationContext::isMultithreaded()), the
+/// global scope of a symbol table is shared by all threads and guarded by a mutex, while the
+/// function-local scopes pushed on top of it are kept separately for each thread. Otherwise, the
+/// symbol table is accessed without locking.
 class SymbolTable {
 public:
-    SymbolTable() : scopes(1) {}
-    void pushScope(Decl* parent) { scopes.emplace_back().parent = parent; }
-    void popScope() { scopes.pop_back(); }
-    Scope& getCurrentScope() { return scopes.back(); }
-    void add(llvm::StringRef name, Decl* decl) { scopes.back().decls[name].push_back(decl); }
-    void addGlobal(llvm::StringRef name, Decl* decl) { scopes.front().decls[name].push_back(decl); }
+    void pushScope(Decl* parent) { getLocalScopes().emplace_back().parent = parent; }
+    void popScope() { getLocalScopes().pop_back(); }
+    Scope& getCurrentScope() {
+        auto& localScopes = getLocalScopes();
+        return localScopes.empty() ? globalScope : localScopes.back();
+    }
+    const Scope& getGlobalScope() const { return globalScope; }
+    const llvm::StringMap<std::string>& getIdentifierReplacements() const { return identifierReplacements; }
+    void add(llvm::StringRef name, Decl* decl) {
+        auto& localScopes = getLocalScopes();
+        if (localScopes.empty()) {
+            addGlobal(name, decl);
+        } else {
+            localScopes.back().decls[name].push_back(decl);
+        }
+    }
+    void addGlobal(llvm::StringRef name, Decl* decl) {
+        auto lock = lockIfMultithreaded(globalScopeMutex);
+        globalScope.decls[name].push_back(decl);
+    }
     void addIdentifierReplacement(llvm::StringRef name, llvm::StringRef replacement) {
         identifierReplacements.try_emplace(name, replacement);
     }
-    bool contains(const std::string& name) const { return !find(name).empty(); }
-    bool containsInCurrentScope(const std::string& name) const { return !findInCurrentScope(name).empty(); }
+    bool contains(llvm::StringRef name) const { return !find(name).empty(); }
+    bool containsInCurrentScope(llvm::StringRef name) const { return !findInCurrentScope(name).empty(); }
 
-    llvm::ArrayRef<Decl*> find(const std::string& name) const {
+    LookupResult find(llvm::StringRef name) const {
         auto realName = applyIdentifierReplacements(name);
 
-        for (const auto& scope : llvm::reverse(scopes)) {
+        for (const auto& scope : llvm::reverse(getLocalScopes())) {
             auto it = scope.decls.find(realName);
-            if (it != scope.decls.end()) return it->second;
+            if (it != scope.decls.end()) return LookupResult(it->second, false);
         }
-        return {};
+        return findGlobal(realName);
     }
 
     Decl* findOne(const std::string& name) const {
@@ -76,11 +124,12 @@ public:
         }
     }
 
-    llvm::ArrayRef<Decl*> findInCurrentScope(const std::string& name) const {
-        if (!scopes.empty()) {
-            auto it = scopes.back().decls.find(applyIdentifierReplacements(name));
-            if (it != scopes.back().decls.end()) return it->second;
-        }
+    LookupResult findInCurrentScope(llvm::StringRef name) const {
+        auto& localScopes = getLocalScopes();
+        if (localScopes.empty()) return findGlobal(applyIdentifierReplacements(name));
+
+        auto it = localScopes.back().decls.find(applyIdentifierReplacements(name));
+        if (it != localScopes.back().decls.end()) return LookupResult(it->second, false);
         return {};
     }
 
@@ -107,7 +156,24 @@ private:
         }
     }
 
-    std::vector<Scope> scopes;
+    LookupResult findGlobal(llvm::StringRef name) const {
+        bool isMultithreaded = CompilationContext::isMultithreaded();
+        std::shared_lock<std::shared_mutex> lock(globalScopeMutex, std::defer_lock);
+        if (isMultithreaded) lock.lock();
+        auto it = globalScope.decls.find(name);
+        if (it != globalScope.decls.end()) return LookupResult(it->second, isMultithreaded);
+        return {};
+    }
+
+    std::vector<Scope>& getLocalScopes() const {
+        return CompilationContext::isMultithreaded() ? getThreadLocalScopes() : localScopes;
+    }
+    std::vector<Scope>& getThreadLocalScopes() const;
+
+    Scope globalScope;
+    /// The local scopes used when only one thread accesses the symbol table.
+    mutable std::vector<Scope> localScopes;
+    mutable std::shared_mutex globalScopeMutex;
     llvm::StringMap<std::string> identifierReplacements;
 };
 
@@ -120,6 +186,10 @@ public:
     llvm::MutableArrayRef<SourceFile> getSourceFiles() { return sourceFiles; }
     llvm::StringRef getName() const { return name; }
     SymbolTable& getSymbolTable() { return symbolTable; }
+    const SymbolTable& getSymbolTable() const { return symbolTable; }
+    /// For modules imported from C headers, the paths of all the files Clang read for the header.
+    llvm::ArrayRef<std::string> getHeaderFiles() const { return headerFiles; }
+    void setHeaderFiles(std::vector<std::string>&& files) { headerFiles = std::move(files); }
 
     std::vector<Module*> getImportedModules() const {
         std::vector<Module*> importedModules;
@@ -150,6 +220,7 @@ private:
 private:
     std::string name;
     std::vector<SourceFile> sourceFiles;
+    std::vector<std::string> headerFiles;
     SymbolTable symbolTable;
     static llvm::StringMap<Module*> allImportedModules;
 };
@@ -4,6 +4,7 @@
 #pragma warning(push, 0)
 #include <llvm/Support/Casting.h>
 #pragma warning(pop)
+#include "compilation-context.h"
 #include "expr.h"
 
 namespace delta {
@@ -24,7 +25,7 @@ enum class StmtKind {
     CompoundStmt
 };
 
-class Stmt {
+class Stmt : public ArenaAllocated {
 public:
     virtual ~Stmt() = 0;
 
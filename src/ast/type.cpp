@@ -1,21 +1,38 @@
 #include "type.h"
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 #pragma warning(push, 0)
+#include <llvm/ADT/Hashing.h>
+#include <llvm/ADT/STLExtras.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/ADT/StringSwitch.h>
 #include <llvm/Support/ErrorHandling.h>
 #pragma warning(pop)
 #include "decl.h"
+#include "../support/statistics.h"
 #include "../support/utility.h"
 
 using namespace delta;
 
-static std::vector<TypeBase*> typeBases;
+/// Maps structural hashes of types to the unique TypeBase objects with that hash. Every TypeBase is
+/// created through this table, so structurally equal types share the same TypeBase object. The table
+/// is split into shards by hash, each with its own lock, so that threads typechecking in parallel
+/// rarely contend with each other. The locks are only taken while typechecking in parallel.
+struct TypeBaseShard {
+    std::mutex mutex;
+    std::unordered_multimap<size_t, TypeBase*> typeBases;
+};
+
+static TypeBaseShard& getTypeBaseShard(size_t hash) {
+    static TypeBaseShard shards[32];
+    return shards[hash % llvm::array_lengthof(shards)];
+}
 
 #define DEFINE_BUILTIN_TYPE_GET_AND_IS(TYPE, NAME) \
     Type Type::get##TYPE(Mutability mutability, SourceLocation location) { \
-        static BasicType type(#NAME, /*genericArgs*/ {}); \
-        return Type(&type, mutability, location); \
+        static TypeBase* typeBase = BasicType::get(#NAME, /*genericArgs*/ {}).getBase(); \
+        return Type(typeBase, mutability, location); \
     } \
     bool Type::is##TYPE() const { return isBasicType() && getName() == #NAME; }
 
@@ -124,19 +141,90 @@ Type Type::resolve(const llvm::StringMap<Type>& replacements) const {
     llvm_unreachable("all cases handled");
 }
 
+llvm::hash_code delta::hash_value(Type type) {
+    return llvm::hash_combine(type.getBase(), type.getMutability());
+}
+
+static llvm::hash_code hashTypeBase(const TypeBase& typeBase) {
+    switch (typeBase.getKind()) {
+        case TypeKind::BasicType: {
+            auto& basicType = llvm::cast<BasicType>(typeBase);
+            auto genericArgs = basicType.getGenericArgs();
+            return llvm::hash_combine(typeBase.getKind(), basicType.getName(), llvm::hash_combine_range(genericArgs.begin(), genericArgs.end()));
+        }
+        case TypeKind::ArrayType: {
+            auto& arrayType = llvm::cast<ArrayType>(typeBase);
+            return llvm::hash_combine(typeBase.getKind(), arrayType.getElementType(), arrayType.getSize());
+        }
+        case TypeKind::TupleType: {
+            auto hash = llvm::hash_value(typeBase.getKind());
+            for (auto& element : llvm::cast<TupleType>(typeBase).getElements()) {
+                hash = llvm::hash_combine(hash, element.name, element.type);
+            }
+            return hash;
+        }
+        case TypeKind::FunctionType: {
+            auto& functionType = llvm::cast<FunctionType>(typeBase);
+            auto paramTypes = functionType.getParamTypes();
+            return llvm::hash_combine(typeBase.getKind(), functionType.getReturnType(), llvm::hash_combine_range(paramTypes.begin(), paramTypes.end()));
+        }
+        case TypeKind::PointerType:
+            return llvm::hash_combine(typeBase.getKind(), llvm::cast<PointerType>(typeBase).getPointeeType());
+        case TypeKind::OptionalType:
+            return llvm::hash_combine(typeBase.getKind(), llvm::cast<OptionalType>(typeBase).getWrappedType());
+    }
+    llvm_unreachable("all cases handled");
+}
+
+/// Compares the top level of two types structurally. The component types of both types are
+/// already interned, so they can be compared by identity.
+static bool structurallyEqual(const TypeBase& a, const TypeBase& b) {
+    if (a.getKind() != b.getKind()) return false;
+
+    switch (a.getKind()) {
+        case TypeKind::BasicType: {
+            auto& basicTypeA = llvm::cast<BasicType>(a);
+            auto& basicTypeB = llvm::cast<BasicType>(b);
+            return basicTypeA.getName() == basicTypeB.getName() && basicTypeA.getGenericArgs() == basicTypeB.getGenericArgs();
+        }
+        case TypeKind::ArrayType: {
+            auto& arrayTypeA = llvm::cast<ArrayType>(a);
+            auto& arrayTypeB = llvm::cast<ArrayType>(b);
+            return arrayTypeA.getElementType() == arrayTypeB.getElementType() && arrayTypeA.getSize() == arrayTypeB.getSize();
+        }
+        case TypeKind::TupleType:
+            return llvm::cast<TupleType>(a).getElements() == llvm::cast<TupleType>(b).getElements();
+        case TypeKind::FunctionType: {
+            auto& functionTypeA = llvm::cast<FunctionType>(a);
+            auto& functionTypeB = llvm::cast<FunctionType>(b);
+            return functionTypeA.getReturnType() == functionTypeB.getReturnType() && functionTypeA.getParamTypes() == functionTypeB.getParamTypes();
+        }
+        case TypeKind::PointerType:
+            return llvm::cast<PointerType>(a).getPointeeType() == llvm::cast<PointerType>(b).getPointeeType();
+        case TypeKind::OptionalType:
+            return llvm::cast<OptionalType>(a).getWrappedType() == llvm::cast<OptionalType>(b).getWrappedType();
+    }
+    llvm_unreachable("all cases handled");
+}
+
 template<typename T>
 static Type getType(T&& typeBase, Mutability mutability, SourceLocation location) {
-    Type newType(&typeBase, mutability, location);
-
-    for (auto& existingTypeBase : typeBases) {
-        Type existingType(&*existingTypeBase, mutability, location);
-        if (existingType.equalsIgnoreTopLevelMutable(newType)) {
-            return existingType;
+    size_t hash = hashTypeBase(typeBase);
+    auto& shard = getTypeBaseShard(hash);
+    auto lock = lockIfMultithreaded(shard.mutex);
+    auto& typeBases = shard.typeBases;
+    auto range = typeBases.equal_range(hash);
+
+    for (auto it = range.first; it != range.second; ++it) {
+        if (structurallyEqual(*it->second, typeBase)) {
+            return Type(it->second, mutability, location);
         }
     }
 
-    typeBases.push_back(new T(std::forward<T>(typeBase)));
-    return Type(&*typeBases.back(), mutability, location);
+    auto* newTypeBase = new T(std::forward<T>(typeBase));
+    typeBases.emplace(hash, newTypeBase);
+    addToStatistic(Statistic::TypesInterned);
+    return Type(newTypeBase, mutability, location);
 }
 
 Type BasicType::get(llvm::StringRef name, llvm::ArrayRef<Type> genericArgs, Mutability mutability, SourceLocation location) {
@@ -264,26 +352,11 @@ Type Type::getWrappedType() const {
 }
 
 bool delta::operator==(Type lhs, Type rhs) {
-    if (lhs.isMutable() != rhs.isMutable()) return false;
-    return lhs.equalsIgnoreTopLevelMutable(rhs);
+    return lhs.getBase() == rhs.getBase() && lhs.getMutability() == rhs.getMutability();
 }
 
 bool Type::equalsIgnoreTopLevelMutable(Type other) const {
-    switch (getKind()) {
-        case TypeKind::BasicType:
-            return other.isBasicType() && getName() == other.getName() && getGenericArgs() == other.getGenericArgs();
-        case TypeKind::ArrayType:
-            return other.isArrayType() && getElementType() == other.getElementType() && getArraySize() == other.getArraySize();
-        case TypeKind::TupleType:
-            return other.isTupleType() && getTupleElements() == other.getTupleElements();
-        case TypeKind::FunctionType:
-            return other.isFunctionType() && getReturnType() == other.getReturnType() && getParamTypes() == other.getParamTypes();
-        case TypeKind::PointerType:
-            return other.isPointerType() && getPointee() == other.getPointee();
-        case TypeKind::OptionalType:
-            return other.isOptionalType() && getWrappedType() == other.getWrappedType();
-    }
-    llvm_unreachable("all cases handled");
+    return typeBase == other.typeBase;
 }
 
 bool delta::operator!=(Type lhs, Type rhs) {
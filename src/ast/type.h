@@ -5,11 +5,13 @@
 #include <vector>
 #pragma warning(push, 0)
 #include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/Hashing.h>
 #include <llvm/ADT/StringMap.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
 #include <llvm/Support/raw_ostream.h>
 #pragma warning(pop)
+#include "compilation-context.h"
 #include "../support/utility.h"
 
 namespace delta {
@@ -30,7 +32,7 @@ enum class TypeKind {
     OptionalType,
 };
 
-class TypeBase {
+class TypeBase : public ArenaAllocated {
 public:
     virtual ~TypeBase() = 0;
     TypeKind getKind() const { return kind; }
@@ -112,6 +114,7 @@ public:
     TypeKind getKind() const { return typeBase->getKind(); }
     TypeDecl* getDecl() const;
     DeinitDecl* getDeinitializer() const;
+    /// Types are interned, so this is an identity comparison of the underlying TypeBase objects.
     bool equalsIgnoreTopLevelMutable(Type) const;
     void printTo(std::ostream& stream, bool omitTopLevelConst) const;
     std::string toString(bool omitTopLevelMutable) const;
@@ -278,6 +281,7 @@ private:
 
 bool operator==(Type, Type);
 bool operator!=(Type, Type);
+llvm::hash_code hash_value(Type);
 std::ostream& operator<<(std::ostream&, Type);
 llvm::raw_ostream& operator<<(llvm::raw_ostream&, Type);
 
@@ -0,0 +1,235 @@
+#include "build-cache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <system_error>
+#include <vector>
+#pragma warning(push, 0)
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/Process.h>
+#include <llvm/Support/raw_ostream.h>
+#pragma warning(pop)
+#include "driver.h"
+#include "../ast/module.h"
+#include "../support/utility.h"
+
+using namespace delta;
+
+static void hashStrings(llvm::MD5& hasher, llvm::ArrayRef<std::string> strings) {
+    for (auto& string : strings) {
+        hasher.update(string);
+        hasher.update(llvm::StringRef("", 1));
+    }
+    hasher.update("\n");
+}
+
+BuildCache::BuildCache(llvm::StringRef directory, const CompileOptions& options, llvm::ArrayRef<std::string> inputDirectories, bool optimize,
+                       bool unchecked, const char* argv0)
+: directory(directory) {
+    llvm::MD5 hasher;
+
+    // Identify the compiler version by the path, size, and modification time of its executable.
+    auto compilerPath = llvm::sys::fs::getMainExecutable(argv0, (void*) (intptr_t) &hashStrings);
+    llvm::sys::fs::file_status compilerStatus;
+    if (!llvm::sys::fs::status(compilerPath, compilerStatus)) {
+        hasher.update(compilerPath);
+        hasher.update(std::to_string(compilerStatus.getSize()));
+        hasher.update(std::to_string(compilerStatus.getLastModificationTime().time_since_epoch().count()));
+    }
+
+    hashStrings(hasher, options.disabledWarnings);
+    hashStrings(hasher, options.frameworkSearchPaths);
+    hashStrings(hasher, options.defines);
+    hashStrings(hasher, options.cflags);
+    hasher.update(optimize ? "optimize\n" : "\n");
+    hasher.update(unchecked ? "unchecked\n" : "\n");
+
+    // The standard library is shared by builds in different directories, so its key leaves out the directories of the
+    // input files, which are only searched for the imports of the program.
+    auto stdlibHasher = hasher;
+    std::vector<std::string> stdlibImportSearchPaths;
+    for (auto& path : options.importSearchPaths) {
+        if (!llvm::is_contained(inputDirectories, path)) stdlibImportSearchPaths.push_back(path);
+    }
+    hashStrings(stdlibHasher, stdlibImportSearchPaths);
+    hashStrings(hasher, options.importSearchPaths);
+
+    llvm::MD5::MD5Result result;
+    hasher.final(result);
+    compilerAndOptionsHash = result.digest().str();
+    stdlibHasher.final(result);
+    stdlibCompilerAndOptionsHash = result.digest().str();
+}
+
+llvm::Optional<llvm::MD5::MD5Result> BuildCache::getSourceHash(const Module& module) {
+    auto it = sourceHashes.find(&module);
+    if (it != sourceHashes.end()) return it->second;
+
+    llvm::Optional<llvm::MD5::MD5Result> sourceHash;
+
+    if (!module.getSourceFiles().empty()) {
+        llvm::MD5 hasher;
+        hasher.update(module.getName());
+        bool readAllSources = true;
+
+        for (auto& sourceFile : module.getSourceFiles()) {
+            auto buffer = llvm::MemoryBuffer::getFile(sourceFile.getFilePath());
+            if (!buffer) {
+                readAllSources = false;
+                break;
+            }
+            hasher.update(sourceFile.getFilePath());
+            hasher.update((*buffer)->getBuffer());
+        }
+
+        if (readAllSources) {
+            sourceHash.emplace();
+            hasher.final(*sourceHash);
+        }
+    } else if (!module.getHeaderFiles().empty()) {
+        // Imported C headers are identified by the path, size, and modification time of every file Clang read for them.
+        llvm::MD5 hasher;
+        hasher.update(module.getName());
+        bool statAllHeaders = true;
+
+        for (auto& headerFile : module.getHeaderFiles()) {
+            llvm::sys::fs::file_status status;
+            if (llvm::sys::fs::status(headerFile, status)) {
+                statAllHeaders = false;
+                break;
+            }
+            hashStrings(hasher, { headerFile, std::to_string(status.getSize()),
+                                  std::to_string(status.getLastModificationTime().time_since_epoch().count()) });
+        }
+
+        if (statAllHeaders) {
+            sourceHash.emplace();
+            hasher.final(*sourceHash);
+        }
+    }
+
+    sourceHashes[&module] = sourceHash;
+    return sourceHash;
+}
+
+std::string BuildCache::getKey(const Module& module, llvm::ArrayRef<Module*> precedingModules) {
+    llvm::MD5 hasher;
+    hasher.update(module.getName() == "std" ? stdlibCompilerAndOptionsHash : compilerAndOptionsHash);
+
+    auto ownSourceHash = getSourceHash(module);
+    if (!ownSourceHash) return "";
+    hasher.update(ownSourceHash->Bytes);
+
+    // Include the sources of all transitively imported modules and all modules generated before this one.
+    llvm::SmallPtrSet<const Module*, 16> visited = { &module };
+    llvm::SmallVector<const Module*, 16> worklist(precedingModules.begin(), precedingModules.end());
+    append(worklist, module.getImportedModules());
+
+    while (!worklist.empty()) {
+        auto* dependency = worklist.pop_back_val();
+        if (!visited.insert(dependency).second) continue;
+
+        auto sourceHash = getSourceHash(*dependency);
+        if (!sourceHash) return "";
+        hasher.update(dependency->getName());
+        hasher.update(sourceHash->Bytes);
+
+        append(worklist, dependency->getImportedModules());
+    }
+
+    llvm::MD5::MD5Result result;
+    hasher.final(result);
+    return result.digest().str();
+}
+
+/// The number of entries kept for each module, see BuildCache::store().
+static const size_t maxEntriesPerModule = 4;
+
+/// Returns the file name prefix of the cache entries of the given module.
+static std::string getEntryPrefix(llvm::StringRef moduleName) {
+    std::string prefix = moduleName;
+    std::replace(prefix.begin(), prefix.end(), '/', '_');
+    return prefix + "-";
+}
+
+/// Returns true if the file name is that of a cache entry of the given module, i.e. the prefix followed by a key (an
+/// MD5 digest in hex) and the extension. Entries of other modules may have the same prefix, e.g. 'foo-bar' for 'foo'.
+static bool isEntryOf(llvm::StringRef fileName, llvm::StringRef moduleName) {
+    auto prefix = getEntryPrefix(moduleName);
+    if (!fileName.startswith(prefix) || !fileName.endswith(".bc")) return false;
+
+    auto key = fileName.drop_front(prefix.size()).drop_back(llvm::StringRef(".bc").size());
+    return key.size() == 32 && llvm::all_of(key, llvm::isHexDigit);
+}
+
+std::string BuildCache::getEntryPath(llvm::StringRef moduleName, llvm::StringRef key) const {
+    llvm::SmallString<128> path(directory);
+    llvm::sys::path::append(path, getEntryPrefix(moduleName) + key + ".bc");
+    return path.str().str();
+}
+
+std::unique_ptr<llvm::Module> BuildCache::load(llvm::StringRef moduleName, llvm::StringRef key, llvm::LLVMContext& ctx) const {
+    auto entryPath = getEntryPath(moduleName, key);
+    int fd;
+    if (llvm::sys::fs::openFileForRead(entryPath, fd)) return nullptr;
+
+    // Mark the entry as recently used, so that store() evicts other entries first.
+    llvm::sys::fs::setLastAccessAndModificationTime(fd, std::chrono::system_clock::now());
+    auto buffer = llvm::MemoryBuffer::getOpenFile(fd, entryPath, -1);
+    llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+    if (!buffer) return nullptr;
+
+    auto module = llvm::parseBitcodeFile((*buffer)->getMemBufferRef(), ctx);
+    if (!module) {
+        llvm::consumeError(module.takeError());
+        return nullptr;
+    }
+
+    return std::move(*module);
+}
+
+void BuildCache::store(llvm::StringRef moduleName, llvm::StringRef key, const llvm::Module& module) const {
+    // The cache is only an optimization, so failing to write to it isn't an error.
+    if (llvm::sys::fs::create_directories(directory)) return;
+
+    auto entryPath = getEntryPath(moduleName, key);
+
+    // Evict the least recently used entries of this module to make room for the new one. Builds with different options
+    // share the per-user cache, so more than one entry is kept to avoid evicting each other's entries.
+    std::vector<std::pair<llvm::sys::TimePoint<>, std::string>> entries;
+    std::error_code error;
+    for (llvm::sys::fs::directory_iterator it(directory, error), end; it != end && !error; it.increment(error)) {
+        if (it->path() == entryPath || !isEntryOf(llvm::sys::path::filename(it->path()), moduleName)) continue;
+        if (auto status = it->status()) entries.emplace_back(status->getLastModificationTime(), it->path());
+    }
+
+    if (entries.size() >= maxEntriesPerModule) {
+        llvm::sort(entries, std::greater<>());
+        for (size_t i = maxEntriesPerModule - 1; i < entries.size(); ++i) {
+            llvm::sys::fs::remove(entries[i].second);
+        }
+    }
+
+    // Write to a temporary file first so that concurrent builds never see partially written entries.
+    llvm::SmallString<128> temporaryPath;
+    int fd;
+    if (llvm::sys::fs::createUniqueFile(getEntryPath(moduleName, "%%%%%%%%.tmp"), fd, temporaryPath)) return;
+
+    {
+        llvm::raw_fd_ostream file(fd, true);
+        llvm::WriteBitcodeToFile(module, file);
+    }
+
+    if (llvm::sys::fs::rename(temporaryPath, entryPath)) {
+        llvm::sys::fs::remove(temporaryPath);
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#pragma warning(push, 0)
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/Optional.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/MD5.h>
+#pragma warning(pop)
+
+namespace llvm {
+class LLVMContext;
+class Module;
+} // namespace llvm
+
+namespace delta {
+
+class Module;
+struct CompileOptions;
+
+/// Persistent on-disk cache of the LLVM bitcode generated for each module, stored under the package
+/// output directory. The cache key of a module covers its own sources, the sources of the modules it
+/// imports (for C headers, the path, size, and modification time of every file Clang read for them),
+/// the sources of the modules generated before it (since each function instantiation is emitted only
+/// into the first module that needs it), the compile options, and the compiler binary.
+/// Optimized, unchecked, and default builds are cached separately, since they generate different code.
+/// The key of the standard library doesn't depend on the directories of the input files, so that builds
+/// in different directories can share it. A few entries are kept per module, evicting the least recently
+/// used ones, so that builds with different options can share a cache directory.
+class BuildCache {
+public:
+    BuildCache(llvm::StringRef directory, const CompileOptions& options, llvm::ArrayRef<std::string> inputDirectories, bool optimize,
+               bool unchecked, const char* argv0);
+    /// Returns an empty string if the module can't be cached, e.g. if some of its sources can't be read.
+    std::string getKey(const Module& module, llvm::ArrayRef<Module*> precedingModules);
+    std::unique_ptr<llvm::Module> load(llvm::StringRef moduleName, llvm::StringRef key, llvm::LLVMContext& ctx) const;
+    void store(llvm::StringRef moduleName, llvm::StringRef key, const llvm::Module& module) const;
+
+private:
+    llvm::Optional<llvm::MD5::MD5Result> getSourceHash(const Module& module);
+    std::string getEntryPath(llvm::StringRef moduleName, llvm::StringRef key) const;
+
+private:
+    std::string directory;
+    std::string compilerAndOptionsHash;
+    std::string stdlibCompilerAndOptionsHash;
+    llvm::DenseMap<const Module*, llvm::Optional<llvm::MD5::MD5Result>> sourceHashes;
+};
+
+} // namespace delta
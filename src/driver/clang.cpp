@@ -6,21 +6,69 @@
 #include <clang/Basic/DiagnosticIDs.h>
 #include <clang/Driver/Compilation.h>
 #include <clang/Driver/Driver.h>
+#include <clang/Driver/Job.h>
+#include <clang/Driver/Tool.h>
+#include <clang/Driver/ToolChain.h>
 #include <clang/Frontend/TextDiagnosticPrinter.h>
 #include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/Support/Host.h>
 #include <llvm/Support/Path.h>
 #include <llvm/Support/VirtualFileSystem.h> // Fixes "error: invalid use of incomplete type ‘class llvm::vfs::FileSystem’" on GCC.
 #include <llvm/Support/raw_ostream.h>
+#ifdef DELTA_HAS_LLD
+#include <lld/Common/Driver.h>
+#endif
 #pragma warning(pop)
 
-int delta::invokeClang(llvm::ArrayRef<const char*> args) {
+using namespace delta;
+
+bool delta::hasInProcessLinker() {
+#ifdef DELTA_HAS_LLD
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef DELTA_HAS_LLD
+/// Returns the arguments of the compilation's link job if it consists of only that job and targets ELF, so that it
+/// can be performed by lld. The linker arguments computed by the Clang driver (startup files, library paths, the
+/// dynamic linker, etc.) are the same for lld as for the system linker.
+static bool getELFLinkJobArgs(const clang::driver::Compilation& compilation, llvm::SmallVectorImpl<const char*>& args) {
+    if (!compilation.getDefaultToolChain().getTriple().isOSBinFormatELF()) return false;
+
+    auto& jobs = compilation.getJobs();
+    if (jobs.size() != 1) return false;
+
+    auto& job = *jobs.begin();
+    if (!job.getCreator().isLinkJob()) return false;
+
+    args.push_back("ld.lld");
+    args.append(job.getArguments().begin(), job.getArguments().end());
+    return true;
+}
+#endif
+
+int delta::invokeClang(llvm::ArrayRef<const char*> args, bool linkInProcess) {
     auto* diagClient = new clang::TextDiagnosticPrinter(llvm::errs(), new clang::DiagnosticOptions());
     diagClient->setPrefix(llvm::sys::path::filename(args[0]));
     clang::DiagnosticsEngine diags(new clang::DiagnosticIDs(), nullptr, diagClient);
     clang::driver::Driver driver(args[0], llvm::sys::getDefaultTargetTriple(), diags);
     std::unique_ptr<clang::driver::Compilation> compilation(driver.BuildCompilation(args));
     if (compilation) {
+#ifdef DELTA_HAS_LLD
+        // lld keeps global state between links, so only the first link in the process is done in-process.
+        static bool hasLinkedInProcess = false;
+        llvm::SmallVector<const char*, 32> linkerArgs;
+
+        if (linkInProcess && !hasLinkedInProcess && !compilation->containsError() && getELFLinkJobArgs(*compilation, linkerArgs)) {
+            hasLinkedInProcess = true;
+            return lld::elf::link(linkerArgs, false) ? 0 : 1;
+        }
+#else
+        (void) linkInProcess;
+#endif
         llvm::SmallVector<std::pair<int, const clang::driver::Command*>, 4> failingCommands;
         return driver.ExecuteCompilation(*compilation, failingCommands);
     }
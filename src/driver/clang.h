@@ -7,6 +7,12 @@ class ArrayRef;
 
 namespace delta {
 
-int invokeClang(llvm::ArrayRef<const char*> args);
+/// Runs the Clang driver with the given arguments. If linkInProcess is true, the link job is performed by calling lld
+/// as a library instead of spawning a linker process. This requires that the compiler was built with lld
+/// (DELTA_HAS_LLD) and is supported only for ELF targets; otherwise a linker process is spawned as usual.
+int invokeClang(llvm::ArrayRef<const char*> args, bool linkInProcess = false);
+
+/// Returns true if the compiler was built with lld, so that invokeClang() can link in-process.
+bool hasInProcessLinker();
 
 } // namespace delta
@@ -1,35 +1,52 @@
 #include "driver.h"
+#include <algorithm>
 #include <cstdio>
 #include <string>
 #include <system_error>
 #include <vector>
 #pragma warning(push, 0)
+#include <llvm/ADT/Optional.h>
 #include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringMap.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/ADT/StringSet.h>
+#include <llvm/BinaryFormat/Magic.h>
+#include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Module.h>
 #include <llvm/Linker/Linker.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/MC/SubtargetFeature.h>
 #include <llvm/Support/CodeGen.h>
 #include <llvm/Support/CommandLine.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Support/InitLLVM.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Path.h>
 #include <llvm/Support/Process.h>
 #include <llvm/Support/Program.h>
 #include <llvm/Support/TargetRegistry.h>
 #include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/Threading.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
+#include <llvm/Transforms/IPO.h>
+#include <llvm/Transforms/IPO/Internalize.h>
 #pragma warning(pop)
+#include "build-cache.h"
 #include "clang.h"
 #include "../ast/module.h"
 #include "../irgen/irgen.h"
 #include "../package-manager/manifest.h"
 #include "../package-manager/package-manager.h"
+#include "../parser/lex.h"
 #include "../parser/parse.h"
 #include "../sema/typecheck.h"
+#include "../support/statistics.h"
 #include "../support/utility.h"
 
 #ifdef _MSC_VER
@@ -45,6 +62,7 @@ namespace delta {
 cl::SubCommand build("build", "Build a Delta project");
 cl::SubCommand run("run", "Build and run a Delta executable");
 cl::list<std::string> inputs(cl::Positional, cl::desc("<input files>"), cl::sub(*cl::AllSubCommands));
+cl::opt<bool> lex("lex", cl::desc("Tokenize only"), cl::Hidden);
 cl::opt<bool> parse("parse", cl::desc("Parse only"));
 cl::opt<bool> typecheck("typecheck", cl::desc("Parse and type-check only"));
 cl::opt<bool> compileOnly("c", cl::desc("Compile only, generating an object file; don't link"));
@@ -53,6 +71,10 @@ cl::opt<bool> emitAssembly("emit-assembly", cl::desc("Emit assembly code"));
 cl::opt<bool> emitBitcode("emit-llvm-bitcode", cl::desc("Emit LLVM bitcode"));
 cl::opt<bool> emitPositionIndependentCode("fPIC", cl::desc("Emit position-independent code"), cl::sub(*cl::AllSubCommands));
 cl::opt<std::string> specifiedOutputFileName("o", cl::desc("Specify output file name"));
+cl::opt<unsigned> optimizationLevel("O", cl::desc("Optimization level (0-3)"), cl::value_desc("level"), cl::Prefix, cl::ZeroOrMore,
+                                    cl::init(0), cl::sub(*cl::AllSubCommands));
+cl::opt<std::string> targetCPU("mcpu", cl::desc("Target a specific CPU, or 'native' for the host CPU"), cl::value_desc("cpu"),
+                               cl::init("generic"), cl::sub(*cl::AllSubCommands));
 cl::opt<WarningMode> warningMode(cl::desc("Warning mode:"), cl::sub(*cl::AllSubCommands),
                                  cl::values(clEnumValN(WarningMode::Suppress, "w", "Suppress all warnings"),
                                             clEnumValN(WarningMode::TreatAsErrors, "Werror", "Treat warnings as errors")));
@@ -64,6 +86,23 @@ cl::list<std::string> frameworkSearchPaths("F", cl::desc("Add directory framewor
                                            cl::sub(*cl::AllSubCommands));
 cl::list<std::string> cflags(cl::Sink, cl::desc("Add C compiler flags"), cl::sub(*cl::AllSubCommands));
 cl::alias emitAssemblyAlias("S", cl::aliasopt(emitAssembly));
+cl::opt<unsigned> jobs("j", cl::desc("Generate code for each module in parallel using N threads (0 = number of cores)"), cl::value_desc("N"),
+                       cl::Prefix, cl::init(1), cl::sub(*cl::AllSubCommands));
+cl::opt<unsigned> typecheckJobs("typecheck-jobs", cl::desc("Typecheck function bodies in parallel using N threads (experimental)"),
+                                cl::value_desc("N"), cl::init(1), cl::sub(*cl::AllSubCommands));
+cl::opt<bool> inProcessLinker("in-process-linker", cl::desc("Link executables by calling lld as a library instead of spawning a linker process"),
+                              cl::sub(*cl::AllSubCommands));
+cl::opt<bool> timeReport("time-report", cl::desc("Print the time spent in each compiler phase"), cl::sub(*cl::AllSubCommands));
+cl::opt<bool> printStats("stats", cl::desc("Print compiler statistics"), cl::sub(*cl::AllSubCommands));
+cl::opt<std::string> traceJSON("trace-json", cl::desc("Write the time spent in each compiler phase to a Chrome trace file"),
+                               cl::value_desc("file"), cl::sub(*cl::AllSubCommands));
+cl::opt<bool> unchecked("unchecked", cl::desc("Omit runtime checks: assertions, null checks of unwrapped optionals, and List bounds checks"),
+                        cl::sub(*cl::AllSubCommands));
+cl::opt<bool> noCache("no-cache", cl::desc("Don't read or write the compiler's caches, e.g. the precompiled standard library"),
+                      cl::sub(*cl::AllSubCommands));
+cl::opt<bool> lto("flto", cl::desc("Optimize the program together with the LLVM bitcode files among the inputs at link time"),
+                  cl::sub(*cl::AllSubCommands));
+cl::alias targetArchAlias("march", cl::desc("Alias for -mcpu"), cl::aliasopt(targetCPU));
 } // namespace delta
 
 static int exec(const char* command, std::string& output) {
@@ -97,14 +136,67 @@ static void addHeaderSearchPathsFromEnvVar(const char* name) {
     }
 }
 
+/// Returns the path of the file in which the header search paths of the given C compiler are cached, or an empty
+/// string if there's no suitable location for it. The cache is invalidated when the compiler binary changes.
+static std::string getHeaderSearchPathCachePath(llvm::StringRef compilerPath) {
+    if (noCache) return "";
+
+    llvm::sys::fs::file_status status;
+    if (llvm::sys::fs::status(compilerPath, status)) return "";
+
+    llvm::SmallString<128> path;
+    if (!llvm::sys::path::user_cache_directory(path, "delta", "header-search-paths")) return "";
+
+    llvm::MD5 hasher;
+    hasher.update(compilerPath);
+    hasher.update(std::to_string(status.getSize()));
+    hasher.update(std::to_string(status.getLastModificationTime().time_since_epoch().count()));
+
+    llvm::MD5::MD5Result result;
+    hasher.final(result);
+    llvm::sys::path::append(path, result.digest());
+    return path.str().str();
+}
+
+static void storeHeaderSearchPaths(llvm::StringRef cachePath, llvm::StringRef output) {
+    if (llvm::sys::fs::create_directories(llvm::sys::path::parent_path(cachePath))) return;
+
+    // Write to a temporary file first so that concurrent builds never see partially written entries.
+    llvm::SmallString<128> temporaryPath;
+    int fd;
+    if (llvm::sys::fs::createUniqueFile(cachePath + "-%%%%%%%%.tmp", fd, temporaryPath)) return;
+
+    {
+        llvm::raw_fd_ostream out(fd, true);
+        out << output;
+    }
+
+    if (llvm::sys::fs::rename(temporaryPath, cachePath)) {
+        llvm::sys::fs::remove(temporaryPath);
+    }
+}
+
 static void addHeaderSearchPathsFromCCompilerOutput() {
     auto compilerPath = getCCompilerPath();
     if (compilerPath.empty()) return;
 
     if (llvm::sys::path::filename(compilerPath) != "cl.exe") {
-        std::string command = "echo | " + compilerPath + " -E -v - 2>&1 | grep '^ /'";
+        // Running the C compiler takes longer than compiling small programs, so its output is cached.
+        auto cachePath = getHeaderSearchPathCachePath(compilerPath);
+        std::unique_ptr<llvm::MemoryBuffer> cachedOutput;
         std::string output;
-        exec(command.c_str(), output);
+
+        if (!cachePath.empty()) {
+            if (auto buffer = llvm::MemoryBuffer::getFile(cachePath)) cachedOutput = std::move(*buffer);
+        }
+
+        if (cachedOutput) {
+            output = cachedOutput->getBuffer().str();
+        } else {
+            std::string command = "echo | " + compilerPath + " -E -v - 2>&1 | grep '^ /'";
+            exec(command.c_str(), output);
+            if (!cachePath.empty() && !output.empty()) storeHeaderSearchPaths(cachePath, output);
+        }
 
         llvm::SmallVector<llvm::StringRef, 8> lines;
         llvm::SplitString(output, lines, "\n");
@@ -118,7 +210,8 @@ static void addHeaderSearchPathsFromCCompilerOutput() {
     }
 }
 
-static void addPredefinedImportSearchPaths(llvm::ArrayRef<std::string> inputFiles) {
+/// Returns the directories of the input files, which are the first of the added import search paths.
+static std::vector<std::string> addPredefinedImportSearchPaths(llvm::ArrayRef<std::string> inputFiles) {
     llvm::StringSet<> relativeImportSearchPaths;
 
     for (llvm::StringRef filePath : inputFiles) {
@@ -127,8 +220,11 @@ static void addPredefinedImportSearchPaths(llvm::ArrayRef<std::string> inputFile
         relativeImportSearchPaths.insert(directoryPath);
     }
 
+    std::vector<std::string> inputDirectories;
+
     for (auto& keyValue : relativeImportSearchPaths) {
         importSearchPaths.push_back(keyValue.getKey());
+        inputDirectories.push_back(keyValue.getKey());
     }
 
     importSearchPaths.push_back(DELTA_ROOT_DIR);
@@ -139,13 +235,87 @@ static void addPredefinedImportSearchPaths(llvm::ArrayRef<std::string> inputFile
     addHeaderSearchPathsFromEnvVar("CPATH");
     addHeaderSearchPathsFromEnvVar("C_INCLUDE_PATH");
     addHeaderSearchPathsFromEnvVar("INCLUDE");
+    return inputDirectories;
 }
 
-static void emitMachineCode(llvm::Module& module, llvm::StringRef fileName, llvm::TargetMachine::CodeGenFileType fileType, llvm::Reloc::Model relocModel) {
-    llvm::InitializeNativeTarget();
-    llvm::InitializeNativeTargetAsmPrinter();
-    llvm::InitializeNativeTargetAsmParser();
+static llvm::CodeGenOpt::Level getCodeGenOptLevel() {
+    switch (optimizationLevel) {
+        case 0:
+            return llvm::CodeGenOpt::None;
+        case 1:
+            return llvm::CodeGenOpt::Less;
+        case 2:
+            return llvm::CodeGenOpt::Default;
+        case 3:
+            return llvm::CodeGenOpt::Aggressive;
+        default:
+            ABORT("invalid optimization level '-O" << optimizationLevel << "'");
+    }
+}
+
+static llvm::PassBuilder::OptimizationLevel getPassBuilderOptLevel() {
+    switch (optimizationLevel) {
+        case 0:
+            return llvm::PassBuilder::O0;
+        case 1:
+            return llvm::PassBuilder::O1;
+        case 2:
+            return llvm::PassBuilder::O2;
+        case 3:
+            return llvm::PassBuilder::O3;
+        default:
+            ABORT("invalid optimization level '-O" << optimizationLevel << "'");
+    }
+}
+
+/// Returns the CPU name and feature string to pass to the TargetMachine, resolving '-mcpu=native'
+/// to the host CPU and the features it supports.
+static std::pair<std::string, std::string> getTargetCPUAndFeatures() {
+    if (targetCPU != "native") {
+        return { targetCPU.getValue(), "" };
+    }
+
+    llvm::SubtargetFeatures features;
+    llvm::StringMap<bool> hostFeatures;
+
+    if (llvm::sys::getHostCPUFeatures(hostFeatures)) {
+        for (auto& feature : hostFeatures) {
+            features.AddFeature(feature.getKey(), feature.getValue());
+        }
+    }
+
+    return { llvm::sys::getHostCPUName().str(), features.getString() };
+}
+
+/// Runs the standard LLVM optimization pipeline for the current optimization level over the module.
+static void optimize(llvm::Module& module, llvm::TargetMachine& targetMachine) {
+    if (optimizationLevel == 0) return;
+
+    PhaseTimer timer("Optimization", module.getModuleIdentifier());
+    llvm::PipelineTuningOptions tuningOptions;
+    tuningOptions.LoopUnrolling = true;
+    tuningOptions.LoopVectorization = optimizationLevel > 1;
+    tuningOptions.SLPVectorization = optimizationLevel > 1;
+
+    llvm::PassBuilder passBuilder(&targetMachine, tuningOptions);
+    llvm::LoopAnalysisManager loopAnalysisManager;
+    llvm::FunctionAnalysisManager functionAnalysisManager;
+    llvm::CGSCCAnalysisManager cgsccAnalysisManager;
+    llvm::ModuleAnalysisManager moduleAnalysisManager;
+
+    passBuilder.registerModuleAnalyses(moduleAnalysisManager);
+    passBuilder.registerCGSCCAnalyses(cgsccAnalysisManager);
+    passBuilder.registerFunctionAnalyses(functionAnalysisManager);
+    passBuilder.registerLoopAnalyses(loopAnalysisManager);
+    passBuilder.crossRegisterProxies(loopAnalysisManager, functionAnalysisManager, cgsccAnalysisManager, moduleAnalysisManager);
+
+    auto modulePassManager = passBuilder.buildPerModuleDefaultPipeline(getPassBuilderOptLevel());
+    modulePassManager.run(module, moduleAnalysisManager);
+}
 
+/// Emits an object or assembly file for the given module. Thread-safe as long as each thread works
+/// on a module from a different LLVMContext, since each call creates its own TargetMachine.
+static void emitMachineCode(llvm::Module& module, llvm::StringRef fileName, llvm::TargetMachine::CodeGenFileType fileType, llvm::Reloc::Model relocModel) {
     llvm::Triple triple(llvm::sys::getDefaultTargetTriple());
     const std::string& targetTriple = triple.str();
     module.setTargetTriple(targetTriple);
@@ -155,9 +325,17 @@ static void emitMachineCode(llvm::Module& module, llvm::StringRef fileName, llvm
     if (!target) ABORT(errorMessage);
 
     llvm::TargetOptions options;
-    auto* targetMachine = target->createTargetMachine(targetTriple, "generic", "", options, relocModel);
+    // Allows the linker to remove unused functions, which matters when modules are emitted separately in parallel.
+    options.FunctionSections = true;
+    options.DataSections = true;
+    auto [cpu, features] = getTargetCPUAndFeatures();
+    std::unique_ptr<llvm::TargetMachine> targetMachine(
+        target->createTargetMachine(targetTriple, cpu, features, options, relocModel, llvm::None, getCodeGenOptLevel()));
     module.setDataLayout(targetMachine->createDataLayout());
 
+    optimize(module, *targetMachine);
+
+    PhaseTimer timer("Machine code emission", module.getModuleIdentifier());
     std::error_code error;
     llvm::raw_fd_ostream file(fileName, error, llvm::sys::fs::F_None);
     if (error) ABORT(error.message());
@@ -171,6 +349,20 @@ static void emitMachineCode(llvm::Module& module, llvm::StringRef fileName, llvm
     file.flush();
 }
 
+/// Removes the functions and global variables that aren't referenced. If the module is the whole program, everything
+/// except the entry point is internalized first, so that unused public functions are removed as well.
+static void removeUnusedDefinitions(llvm::Module& module, bool isWholeProgram) {
+    PhaseTimer timer("Dead code elimination");
+
+    if (isWholeProgram) {
+        llvm::internalizeModule(module, [](const llvm::GlobalValue& value) { return value.getName() == "main"; });
+    }
+
+    llvm::legacy::PassManager passManager;
+    passManager.add(llvm::createGlobalDCEPass());
+    passManager.run(module);
+}
+
 static void emitLLVMBitcode(const llvm::Module& module, llvm::StringRef fileName) {
     std::error_code error;
     llvm::raw_fd_ostream file(fileName, error, llvm::sys::fs::F_None);
@@ -179,15 +371,114 @@ static void emitLLVMBitcode(const llvm::Module& module, llvm::StringRef fileName
     file.flush();
 }
 
+/// Returns true if the input file is an object file, archive, or LLVM bitcode file, to be passed to the linker
+/// instead of being compiled.
+static bool isLinkerInput(llvm::StringRef filePath) {
+    auto extension = llvm::sys::path::extension(filePath);
+    return extension == ".o" || extension == ".obj" || extension == ".a" || extension == ".lib" || extension == ".bc";
+}
+
+/// Links the LLVM bitcode files among the given linker inputs into the module, so that they're optimized together with
+/// it, e.g. to inline small C functions compiled with 'clang -flto -c' into Delta code. Returns the remaining inputs.
+static std::vector<std::string> linkBitcodeFiles(llvm::Module& module, llvm::ArrayRef<std::string> linkerInputs) {
+    PhaseTimer timer("Linking", "LLVM bitcode files");
+    std::vector<std::string> remainingInputs;
+    llvm::Linker linker(module);
+
+    for (auto& filePath : linkerInputs) {
+        llvm::file_magic magic;
+        if (llvm::identify_magic(filePath, magic) || magic != llvm::file_magic::bitcode) {
+            remainingInputs.push_back(filePath);
+            continue;
+        }
+
+        auto buffer = llvm::MemoryBuffer::getFile(filePath);
+        if (!buffer) ABORT("couldn't open file '" << filePath << "'");
+        auto bitcodeModule = llvm::parseBitcodeFile(**buffer, module.getContext());
+        if (!bitcodeModule) ABORT("couldn't read '" << filePath << "': " << llvm::toString(bitcodeModule.takeError()));
+
+        // Bitcode files compiled from Delta contain the standard library as well, which is merged with the program's.
+        for (auto& global : (*bitcodeModule)->global_values()) {
+            if (!global.isDeclaration() && global.hasExternalLinkage() && global.getName().startswith("_EN3std")) {
+                global.setLinkage(llvm::GlobalValue::LinkOnceODRLinkage);
+            }
+        }
+
+        bool error = linker.linkInModule(std::move(*bitcodeModule));
+        if (error) ABORT("LLVM module linking failed");
+    }
+
+    return remainingInputs;
+}
+
+/// Emits a separate object file for each module, distributing the modules over a thread pool. The
+/// modules are round-tripped through bitcode so that each thread can work in its own LLVMContext.
+static std::vector<std::string> emitObjectFilesInParallel(std::vector<std::unique_ptr<llvm::Module>> modules,
+                                                          llvm::StringRef outputFileExtension, llvm::Reloc::Model relocModel) {
+    std::vector<llvm::SmallString<0>> bitcodes(modules.size());
+    std::vector<std::string> objectFilePaths(modules.size());
+    std::vector<std::string> moduleNames(modules.size());
+
+    for (size_t i = 0; i < modules.size(); ++i) {
+        moduleNames[i] = modules[i]->getModuleIdentifier();
+        llvm::raw_svector_ostream stream(bitcodes[i]);
+        llvm::WriteBitcodeToFile(*modules[i], stream);
+
+        llvm::SmallString<128> objectFilePath;
+        if (auto error = llvm::sys::fs::createTemporaryFile("delta", outputFileExtension, objectFilePath)) {
+            ABORT(error.message());
+        }
+        objectFilePaths[i] = objectFilePath.str().str();
+    }
+
+    modules.clear();
+    llvm::ThreadPool threadPool(jobs == 0 ? llvm::heavyweight_hardware_concurrency() : jobs.getValue());
+
+    for (size_t i = 0; i < bitcodes.size(); ++i) {
+        threadPool.async([&, i] {
+            llvm::LLVMContext ctx;
+            auto module = llvm::parseBitcodeFile(llvm::MemoryBufferRef(bitcodes[i], objectFilePaths[i]), ctx);
+            if (!module) ABORT(llvm::toString(module.takeError()));
+            (*module)->setModuleIdentifier(moduleNames[i]);
+            emitMachineCode(**module, objectFilePaths[i], llvm::TargetMachine::CGFT_ObjectFile, relocModel);
+        });
+    }
+
+    threadPool.wait();
+    return objectFilePaths;
+}
+
+/// Returns the directory of the build cache, or an empty string if there's no suitable location for it.
+/// Packages have their own cache in their output directory; other builds share a per-user cache.
+static std::string getBuildCacheDirectory(const PackageManifest* manifest, llvm::StringRef outputDirectory, llvm::StringRef outputFileName) {
+    llvm::SmallString<128> directory;
+
+    if (manifest) {
+        directory = outputDirectory;
+        llvm::sys::path::append(directory, "cache", outputFileName.empty() ? "main" : outputFileName);
+    } else if (!llvm::sys::path::user_cache_directory(directory, "delta")) {
+        return "";
+    }
+
+    return directory.str().str();
+}
+
 static int buildExecutable(llvm::ArrayRef<std::string> files, const PackageManifest* manifest, const char* argv0,
                            llvm::StringRef outputDirectory, llvm::StringRef outputFileName) {
     if (files.empty()) {
         ABORT("no input files");
     }
 
-    addPredefinedImportSearchPaths(files);
+    std::vector<std::string> sourceFiles;
+    std::vector<std::string> linkerInputs;
+
+    for (auto& filePath : files) {
+        (isLinkerInput(filePath) ? linkerInputs : sourceFiles).push_back(filePath);
+    }
+
+    auto inputDirectories = addPredefinedImportSearchPaths(sourceFiles);
 
-    CompileOptions options = { disabledWarnings, importSearchPaths, frameworkSearchPaths, defines, cflags };
+    CompileOptions options = { disabledWarnings, importSearchPaths, frameworkSearchPaths, defines, cflags, !noCache };
 
     if (!specifiedOutputFileName.empty()) {
         outputFileName = specifiedOutputFileName;
@@ -195,14 +486,45 @@ static int buildExecutable(llvm::ArrayRef<std::string> files, const PackageManif
 
     Module module("main");
 
-    for (llvm::StringRef filePath : files) {
+    for (llvm::StringRef filePath : sourceFiles) {
+        if (lex) {
+            auto buffer = llvm::MemoryBuffer::getFile(filePath);
+            if (!buffer) ABORT("couldn't open file '" << filePath << "'");
+            PhaseTimer timer("Lexing", filePath);
+            Lexer lexer(buffer->release());
+            while (lexer.nextToken() != Token::None) {}
+            continue;
+        }
+
         Parser parser(filePath, module, options);
         parser.parse();
     }
 
-    if (parse) return 0;
+    if (lex || parse) return 0;
 
+    IRGenerator irGenerator;
+    if (optimizationLevel > 0) irGenerator.enableOptimizationHints();
+    if (unchecked) irGenerator.enableUncheckedMode();
+    llvm::Optional<BuildCache> buildCache;
+    std::string stdlibKey;
+    std::unique_ptr<llvm::Module> precompiledStdlib;
     Typechecker typechecker(options);
+    typechecker.setTypecheckThreadCount(typecheckJobs);
+
+    if (!typecheck && !printIR && !noCache) {
+        auto buildCacheDirectory = getBuildCacheDirectory(manifest, outputDirectory, outputFileName);
+        if (!buildCacheDirectory.empty()) buildCache.emplace(buildCacheDirectory, options, inputDirectories, optimizationLevel > 0, unchecked, argv0);
+    }
+
+    if (buildCache) {
+        // The key is computed before the standard library's imports are resolved, so it's reused when storing it below.
+        typechecker.setPrecompiledStdlibLoader([&](const Module& stdModule) {
+            stdlibKey = buildCache->getKey(stdModule, {});
+            if (!stdlibKey.empty()) precompiledStdlib = buildCache->load(stdModule.getName(), stdlibKey, irGenerator.getLLVMContext());
+            return precompiledStdlib != nullptr;
+        });
+    }
+
     for (auto& importedModule : module.getImportedModules()) {
         typechecker.typecheckModule(*importedModule, nullptr);
     }
@@ -215,13 +537,39 @@ static int buildExecutable(llvm::ArrayRef<std::string> files, const PackageManif
 
     if (typecheck) return 0;
 
-    IRGenerator irGenerator;
+    auto modulesToGenerate = Module::getAllImportedModules();
+    // Generate the standard library first so that its code doesn't depend on the other modules.
+    std::stable_partition(modulesToGenerate.begin(), modulesToGenerate.end(), [](Module* m) { return m->getName() == "std"; });
+    modulesToGenerate.push_back(&module);
 
-    for (auto* module : Module::getAllImportedModules()) {
-        irGenerator.codegenModule(*module);
+    for (size_t i = 0; i < modulesToGenerate.size(); ++i) {
+        auto& moduleToGenerate = *modulesToGenerate[i];
+
+        if (precompiledStdlib && moduleToGenerate.getName() == "std") {
+            irGenerator.addPrecompiledModule(std::move(precompiledStdlib));
+            continue;
+        }
+
+        // Outside of packages, only the standard library is cached.
+        std::string key;
+        if (moduleToGenerate.getName() == "std") {
+            key = stdlibKey;
+        } else if (buildCache && manifest) {
+            key = buildCache->getKey(moduleToGenerate, llvm::makeArrayRef(modulesToGenerate).take_front(i));
+        }
+
+        if (!key.empty()) {
+            if (auto cachedModule = buildCache->load(moduleToGenerate.getName(), key, irGenerator.getLLVMContext())) {
+                irGenerator.addPrecompiledModule(std::move(cachedModule));
+                continue;
+            }
+        }
+
+        auto& generatedModule = irGenerator.codegenModule(moduleToGenerate);
+        if (!key.empty()) buildCache->store(moduleToGenerate.getName(), key, generatedModule);
     }
 
-    auto& mainModule = irGenerator.codegenModule(module);
+    auto& mainModule = irGenerator.getLastGeneratedModule();
 
     if (printIR) {
         mainModule.setModuleIdentifier("");
@@ -230,32 +578,63 @@ static int buildExecutable(llvm::ArrayRef<std::string> files, const PackageManif
         return 0;
     }
 
-    llvm::Module linkedModule("", irGenerator.getLLVMContext());
-    llvm::Linker linker(linkedModule);
-
-    for (auto& module : irGenerator.getGeneratedModules()) {
-        bool error = linker.linkInModule(std::unique_ptr<llvm::Module>(module));
-        if (error) ABORT("LLVM module linking failed");
-    }
-
-    if (emitBitcode) {
-        emitLLVMBitcode(linkedModule, "output.bc");
-        return 0;
-    }
-
     auto ccPath = getCCompilerPath();
     bool msvc = llvm::sys::path::extension(ccPath) == ".exe";
-
-    llvm::SmallString<128> temporaryOutputFilePath;
     auto* outputFileExtension = emitAssembly ? "s" : msvc ? "obj" : "o";
-    if (auto error = llvm::sys::fs::createTemporaryFile("delta", outputFileExtension, temporaryOutputFilePath)) {
-        ABORT(error.message());
-    }
-
-    auto fileType = emitAssembly ? llvm::TargetMachine::CGFT_AssemblyFile : llvm::TargetMachine::CGFT_ObjectFile;
     if (msvc) emitPositionIndependentCode = true;
     auto relocModel = emitPositionIndependentCode ? llvm::Reloc::Model::PIC_ : llvm::Reloc::Model::Static;
-    emitMachineCode(linkedModule, temporaryOutputFilePath, fileType, relocModel);
+
+    auto generatedModules = map(irGenerator.getGeneratedModules(), [](llvm::Module* module) { return std::unique_ptr<llvm::Module>(module); });
+    std::vector<std::string> objectFilePaths;
+
+    // With -flto, the modules are linked together and optimized as a whole, so they can't be emitted in parallel.
+    if (jobs != 1 && !lto && !emitBitcode && !compileOnly && !emitAssembly) {
+        objectFilePaths = emitObjectFilesInParallel(std::move(generatedModules), outputFileExtension, relocModel);
+    } else {
+        llvm::Module linkedModule("", irGenerator.getLLVMContext());
+
+        {
+            PhaseTimer timer("Linking", "LLVM modules");
+            llvm::Linker linker(linkedModule);
+
+            for (auto& module : generatedModules) {
+                bool error = linker.linkInModule(std::move(module));
+                if (error) ABORT("LLVM module linking failed");
+            }
+        }
+
+        bool isWholeProgram = !compileOnly && !emitAssembly && !emitBitcode;
+
+        // Linked before removing unused definitions, so that the Delta definitions used by the bitcode files are kept,
+        // and the unused definitions of the bitcode files are removed.
+        if (lto && isWholeProgram) {
+            linkerInputs = linkBitcodeFiles(linkedModule, linkerInputs);
+        }
+
+        // Object files and libraries linked with the program may call any of its functions, so none can be removed.
+        if (!linkerInputs.empty()) isWholeProgram = false;
+
+        removeUnusedDefinitions(linkedModule, isWholeProgram);
+
+        if (emitBitcode) {
+            emitLLVMBitcode(linkedModule, "output.bc");
+            return 0;
+        }
+
+        llvm::SmallString<128> temporaryOutputFilePath;
+        if (auto error = llvm::sys::fs::createTemporaryFile("delta", outputFileExtension, temporaryOutputFilePath)) {
+            ABORT(error.message());
+        }
+
+        // Like 'clang -flto -c', output bitcode instead of an object file, to be optimized when linking it with -flto.
+        if (lto && compileOnly && !emitAssembly) {
+            emitLLVMBitcode(linkedModule, temporaryOutputFilePath);
+        } else {
+            auto fileType = emitAssembly ? llvm::TargetMachine::CGFT_AssemblyFile : llvm::TargetMachine::CGFT_ObjectFile;
+            emitMachineCode(linkedModule, temporaryOutputFilePath, fileType, relocModel);
+        }
+        objectFilePaths.push_back(temporaryOutputFilePath.str().str());
+    }
 
     if (!outputDirectory.empty()) {
         auto error = llvm::sys::fs::create_directories(outputDirectory);
@@ -265,7 +644,7 @@ static int buildExecutable(llvm::ArrayRef<std::string> files, const PackageManif
     if (compileOnly || emitAssembly) {
         llvm::SmallString<128> outputFilePath = outputDirectory;
         llvm::sys::path::append(outputFilePath, llvm::Twine("output.") + outputFileExtension);
-        renameFile(temporaryOutputFilePath, outputFilePath);
+        renameFile(objectFilePaths[0], outputFilePath);
         return 0;
     }
 
@@ -278,10 +657,19 @@ static int buildExecutable(llvm::ArrayRef<std::string> files, const PackageManif
         ABORT(error.message());
     }
 
-    std::vector<const char*> ccArgs = {
-        msvc ? ccPath.c_str() : argv0,
-        temporaryOutputFilePath.c_str(),
-    };
+    std::vector<const char*> ccArgs = { msvc ? ccPath.c_str() : argv0 };
+
+    for (auto& objectFilePath : objectFilePaths) {
+        ccArgs.push_back(objectFilePath.c_str());
+    }
+
+    for (auto& linkerInput : linkerInputs) {
+        ccArgs.push_back(linkerInput.c_str());
+    }
+
+    if (!msvc) {
+        ccArgs.push_back(llvm::Triple(llvm::sys::getDefaultTargetTriple()).isOSDarwin() ? "-Wl,-dead_strip" : "-Wl,--gc-sections");
+    }
 
     std::string outputPathFlag = ((msvc ? "-Fe" : "-o") + temporaryExecutablePath).str();
     ccArgs.push_back(outputPathFlag.c_str());
@@ -299,8 +687,14 @@ static int buildExecutable(llvm::ArrayRef<std::string> files, const PackageManif
     }
 
     std::vector<llvm::StringRef> ccArgStringRefs(ccArgs.begin(), ccArgs.end());
-    int ccExitStatus = msvc ? llvm::sys::ExecuteAndWait(ccArgs[0], ccArgStringRefs) : invokeClang(ccArgs);
-    llvm::sys::fs::remove(temporaryOutputFilePath);
+    int ccExitStatus;
+    {
+        PhaseTimer timer("Linking", "executable");
+        ccExitStatus = msvc ? llvm::sys::ExecuteAndWait(ccArgs[0], ccArgStringRefs) : invokeClang(ccArgs, inProcessLinker);
+    }
+    for (auto& objectFilePath : objectFilePaths) {
+        llvm::sys::fs::remove(objectFilePath);
+    }
     if (ccExitStatus != 0) return ccExitStatus;
 
     if (run) {
@@ -381,24 +775,40 @@ static void addPlatformDefines() {
 
 int main(int argc, const char** argv) {
     llvm::InitLLVM x(argc, argv);
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+    llvm::InitializeNativeTargetAsmParser();
     cl::ParseCommandLineOptions(argc, argv, "Delta compiler\n");
     addPlatformDefines();
 
+    if (inProcessLinker && !hasInProcessLinker()) {
+        ABORT("-in-process-linker requires a compiler built with lld");
+    }
+
+    if (timeReport) enableTimeReport();
+    if (!traceJSON.empty()) enableTimeTrace();
+    int exitStatus;
+
     try {
         if (!inputs.empty()) {
-            return buildExecutable(inputs, nullptr, argv[0], ".", "");
+            exitStatus = buildExecutable(inputs, nullptr, argv[0], ".", "");
         } else if (build || run) {
             llvm::SmallString<128> currentPath;
             if (auto error = llvm::sys::fs::current_path(currentPath)) {
                 ABORT(error.message());
             }
-            return buildPackage(currentPath, argv[0]);
+            exitStatus = buildPackage(currentPath, argv[0]);
         } else {
             cl::PrintHelpMessage();
-            return 0;
+            exitStatus = 0;
         }
     } catch (const CompileError& error) {
         error.print();
-        return 1;
+        exitStatus = 1;
     }
+
+    if (timeReport) printTimeReport(llvm::errs());
+    if (printStats) printStatistics(llvm::errs());
+    if (!traceJSON.empty()) writeTimeTrace(traceJSON);
+    return exitStatus;
 }
@@ -11,6 +11,8 @@ struct CompileOptions {
     std::vector<std::string> frameworkSearchPaths;
     std::vector<std::string> defines;
     std::vector<std::string> cflags;
+    /// False if the caches in the user cache directory, e.g. that of imported C headers, shouldn't be used.
+    bool useCaches = true;
 };
 
 } // namespace delta
@@ -4,6 +4,7 @@
 #include <llvm/IR/Verifier.h>
 #pragma warning(pop)
 #include "../ast/mangle.h"
+#include "../support/statistics.h"
 
 using namespace delta;
 
@@ -36,19 +37,77 @@ llvm::Function* IRGenerator::getFunctionProto(const FunctionDecl& decl) {
         arg->setName(param->getName());
     }
 
-    auto result = functionInstantiations.try_emplace(std::move(mangled), FunctionInstantiation(decl, function));
-    // TODO: 'result.second' should always be true.
-    // ASSERT(result.second);
+    if (emitOptimizationHints) addFunctionAttributes(decl, *function);
+
+    // Functions defined by a precompiled module are only declared in the current module.
+    if (precompiledFunctions.count(function->getName())) return function;
+
+    auto result = functionInstantiations.try_emplace(mangled, decl, function);
 
     // If the function is from a different module, return the declaration generated in the current module.
-    if (result.first->second.getFunction()->getParent() != &*module) {
+    if (!result.second) {
+        ASSERT(result.first->second.getFunction()->getParent() != &*module);
         return function;
     }
 
-    return result.first->second.getFunction();
+    // The body is generated lazily by codegenModule, unless the function is defined before that.
+    if (!decl.isExtern()) {
+        function->setLinkage(getFunctionLinkage(decl));
+        pendingInstantiations.push_back(&result.first->second);
+    }
+
+    return function;
+}
+
+llvm::GlobalValue::LinkageTypes IRGenerator::getFunctionLinkage(const FunctionDecl& decl) const {
+    if (internalFunctions.count(&decl)) {
+        return llvm::GlobalValue::InternalLinkage;
+    }
+
+    // Instantiations may be defined by multiple separately compiled packages, so duplicates are merged by the linker.
+    // They're defined only in the first module that uses them, so unlike linkonce_odr, the definition must be kept even
+    // if it's unused in that module, since later modules may reference it.
+    if (!decl.getGenericArgs().empty() || (decl.getTypeDecl() && !decl.getTypeDecl()->getGenericArgs().empty())) {
+        return llvm::GlobalValue::WeakODRLinkage;
+    }
+
+    return llvm::GlobalValue::ExternalLinkage;
+}
+
+void IRGenerator::addFunctionAttributes(const FunctionDecl& decl, llvm::Function& function) {
+    // Delta has no exceptions, so no call can unwind.
+    function.addFnAttr(llvm::Attribute::NoUnwind);
+
+    // Extern functions follow C's rules for pointers, so they get no parameter attributes.
+    if (decl.isExtern()) return;
+
+    unsigned index = 0;
+
+    // Methods are always called on an existing object, unlike pointer parameters, which may point one past the end
+    // of an array.
+    if (decl.isMethodDecl()) {
+        function.addParamAttr(index, llvm::Attribute::NonNull);
+        auto* thisType = function.getFunctionType()->getParamType(index)->getPointerElementType();
+
+        if (thisType->isSized()) {
+            if (auto size = module->getDataLayout().getTypeAllocSize(thisType)) {
+                function.addDereferenceableParamAttr(index, size);
+            }
+        }
+
+        ++index;
+    }
+
+    for (auto& param : decl.getParams()) {
+        if (param.getType().isPointerType()) {
+            function.addParamAttr(index, llvm::Attribute::NonNull);
+        }
+        ++index;
+    }
 }
 
 void IRGenerator::codegenFunctionBody(const FunctionDecl& decl, llvm::Function& function) {
+    addToStatistic(Statistic::FunctionsEmitted);
     builder.SetInsertPoint(llvm::BasicBlock::Create(ctx, "", &function));
     beginScope();
     auto arg = function.arg_begin();
@@ -71,22 +130,21 @@ void IRGenerator::codegenFunctionBody(const FunctionDecl& decl, llvm::Function&
     auto* insertBlock = builder.GetInsertBlock();
     if (insertBlock != &function.getEntryBlock() && llvm::pred_empty(insertBlock)) {
         insertBlock->eraseFromParent();
-        return;
-    }
-
-    if (insertBlock->empty() || !llvm::isa<llvm::ReturnInst>(insertBlock->back())) {
+    } else if (insertBlock->empty() || !llvm::isa<llvm::ReturnInst>(insertBlock->back())) {
         if (!decl.isMain()) {
             builder.CreateRetVoid();
         } else {
             builder.CreateRet(llvm::ConstantInt::get(llvm::Type::getInt32Ty(ctx), 0));
         }
     }
+
+    if (emitOptimizationHints) addTBAAMetadata(function);
 }
 
 void IRGenerator::codegenFunctionDecl(const FunctionDecl& decl) {
     llvm::Function* function = getFunctionProto(decl);
 
-    if (!decl.isExtern() && function->empty()) {
+    if (!decl.isExtern() && function->empty() && !precompiledFunctions.count(function->getName())) {
         codegenFunctionBody(decl, *function);
     }
 
@@ -10,18 +10,7 @@ llvm::Value* IRGenerator::codegenVarExpr(const VarExpr& expr) {
 
 llvm::Value* IRGenerator::codegenStringLiteralExpr(const StringLiteralExpr& expr) {
     if (expr.getType().isBasicType() && expr.getType().getName() == "StringRef") {
-        ASSERT(builder.GetInsertBlock(), "CreateGlobalStringPtr requires block to insert into");
-        auto* stringPtr = builder.CreateGlobalStringPtr(expr.getValue());
-        auto* size = llvm::ConstantInt::get(llvm::Type::getInt32Ty(ctx), expr.getValue().size());
-        static int stringLiteralCounter = 0;
-        auto* type = toIR(BasicType::get("StringRef", {}));
-        auto* alloca = createEntryBlockAlloca(type, nullptr, "__str" + std::to_string(stringLiteralCounter++));
-        auto* stringRefInitType = llvm::FunctionType::get(llvm::Type::getVoidTy(ctx),
-                                                          { alloca->getType(), stringPtr->getType(), size->getType() }, false);
-        // TODO: Retrieve this constructor in a nicer way.
-        auto* stringRefInit = module->getOrInsertFunction("_EN3std9StringRef4initE7pointerP4char6length3int", stringRefInitType).getCallee();
-        builder.CreateCall(stringRefInit, { alloca, stringPtr, size });
-        return alloca;
+        return getStringRefLiteral(expr.getValue());
     } else {
         // Passing as C-string, i.e. char pointer.
         ASSERT(expr.getType().removeOptional().isPointerType() && expr.getType().removeOptional().getPointee().isChar());
@@ -29,6 +18,35 @@ llvm::Value* IRGenerator::codegenStringLiteralExpr(const StringLiteralExpr& expr
     }
 }
 
+/// Returns a pointer to a constant StringRef global referring to the given string. Identical literals share a global.
+/// The pointer may be passed as the receiver of StringRef methods, since none of them modify 'this', but arguments that
+/// bind a literal to a mutable pointer parameter must be copied, see codegenCallExpr().
+llvm::GlobalVariable* IRGenerator::getStringRefLiteral(llvm::StringRef value) {
+    auto& global = stringRefLiterals[value];
+    if (global) return global;
+
+    auto* characters = llvm::ConstantDataArray::getString(ctx, value);
+    auto* characterArray = new llvm::GlobalVariable(*module, characters->getType(), true, llvm::GlobalValue::PrivateLinkage, characters);
+    characterArray->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+    characterArray->setAlignment(1);
+
+    // StringRef consists of an ArrayRef<char>, which consists of a pointer and a size.
+    auto* stringRefType = llvm::cast<llvm::StructType>(toIR(BasicType::get("StringRef", {})));
+    auto* arrayRefType = llvm::cast<llvm::StructType>(stringRefType->getElementType(0));
+    llvm::Constant* zero = llvm::ConstantInt::get(llvm::Type::getInt32Ty(ctx), 0);
+    llvm::Constant* indices[] = { zero, zero };
+    llvm::Constant* arrayRefFields[] = {
+        llvm::ConstantExpr::getInBoundsGetElementPtr(characters->getType(), characterArray, indices),
+        llvm::ConstantInt::get(llvm::Type::getInt32Ty(ctx), value.size()),
+    };
+    auto* initializer = llvm::ConstantStruct::get(stringRefType, llvm::ConstantStruct::get(arrayRefType, arrayRefFields));
+
+    global = new llvm::GlobalVariable(*module, stringRefType, true, llvm::GlobalValue::PrivateLinkage, initializer,
+                                      "__str" + std::to_string(stringRefLiterals.size() - 1));
+    global->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+    return global;
+}
+
 llvm::Value* IRGenerator::codegenCharacterLiteralExpr(const CharacterLiteralExpr& expr) {
     return llvm::ConstantInt::get(toIR(expr.getType()), expr.getValue());
 }
@@ -401,6 +419,8 @@ llvm::Value* IRGenerator::codegenBuiltinConversion(const Expr& expr, Type type)
 }
 
 void IRGenerator::codegenAssert(llvm::Value* condition, SourceLocation location, llvm::StringRef message) {
+    if (unchecked) return;
+
     condition = builder.CreateIsNull(condition, "assert.condition");
     auto* function = builder.GetInsertBlock()->getParent();
     auto* failBlock = llvm::BasicBlock::Create(ctx, "assert.fail", function);
@@ -408,8 +428,9 @@ void IRGenerator::codegenAssert(llvm::Value* condition, SourceLocation location,
     auto* puts = module->getOrInsertFunction("puts", llvm::Type::getInt32Ty(ctx), llvm::Type::getInt8PtrTy(ctx)).getCallee();
     builder.CreateCondBr(condition, failBlock, successBlock);
     builder.SetInsertPoint(failBlock);
-    auto messageAndLocation = llvm::join_items("", message, " at ", llvm::sys::path::filename(location.file), ":",
-                                               std::to_string(location.line), ":", std::to_string(location.column));
+    auto decoded = SourceManager::decode(location);
+    auto messageAndLocation = llvm::join_items("", message, " at ", llvm::sys::path::filename(decoded.file), ":",
+                                               std::to_string(decoded.line), ":", std::to_string(decoded.column));
     builder.CreateCall(puts, builder.CreateGlobalStringPtr(messageAndLocation));
     builder.CreateCall(module->getOrInsertFunction("abort", llvm::Type::getVoidTy(ctx)));
     builder.CreateUnreachable();
@@ -513,10 +534,22 @@ llvm::Value* IRGenerator::codegenCallExpr(const CallExpr& expr, llvm::AllocaInst
         ++param;
     }
 
+    auto* functionDecl = llvm::dyn_cast_or_null<FunctionDecl>(calleeDecl);
+
     for (const auto& arg : expr.getArgs()) {
         auto* paramType = param != paramEnd ? *param++ : nullptr;
         auto* argValue = codegenExprForPassing(*arg.getValue(), paramType);
         ASSERT(!paramType || argValue->getType() == paramType);
+
+        // StringRef literals passed by pointer are copied, unless the parameter is known to be a const pointer, since
+        // the callee may write through it and the literal is a shared constant global.
+        if (llvm::isa<StringLiteralExpr>(arg.getValue()) && llvm::isa<llvm::GlobalVariable>(argValue)) {
+            auto index = size_t(&arg - expr.getArgs().begin());
+            bool isConstParam = functionDecl && index < functionDecl->getParams().size() &&
+                                !functionDecl->getParams()[index].getType().removeOptional().getPointee().isMutable();
+            if (!isConstParam) argValue = createTempAlloca(createLoad(argValue), "__str");
+        }
+
         args.push_back(argValue);
     }
 
@@ -1,9 +1,14 @@
 #include "irgen.h"
 #pragma warning(push, 0)
+#include <llvm/ADT/STLExtras.h>
 #include <llvm/ADT/StringSwitch.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/IR/Operator.h>
 #include <llvm/IR/Verifier.h>
 #pragma warning(pop)
 #include "../ast/module.h"
+#include "../support/statistics.h"
 
 using namespace delta;
 
@@ -271,6 +276,67 @@ llvm::Type* IRGenerator::getLLVMTypeForPassing(const TypeDecl& typeDecl) {
     return llvm::PointerType::get(toIR(typeDecl.getType()), 0);
 }
 
+/// Tags the loads and stores of scalar struct fields with TBAA metadata of the field type, which tells LLVM that
+/// accesses of different scalar types don't alias. Struct-path tags, which would also separate different fields and
+/// fields of different structs, aren't used, since pointer casts allow a struct to be accessed as another struct type.
+/// Other memory accesses are left untagged, since pointer casts allow them to access any type.
+void IRGenerator::addTBAAMetadata(llvm::Function& function) {
+    llvm::MDBuilder mdBuilder(ctx);
+
+    for (auto& instruction : llvm::instructions(function)) {
+        llvm::Value* pointer;
+        if (auto* load = llvm::dyn_cast<llvm::LoadInst>(&instruction)) {
+            pointer = load->getPointerOperand();
+        } else if (auto* store = llvm::dyn_cast<llvm::StoreInst>(&instruction)) {
+            pointer = store->getPointerOperand();
+        } else {
+            continue;
+        }
+
+        // Field accesses are generated as 'getelementptr %T, %T* %base, i32 0, i32 <field index>'.
+        auto* gep = llvm::dyn_cast<llvm::GEPOperator>(pointer);
+        if (!gep || gep->getNumIndices() != 2 || !gep->hasAllConstantIndices()) continue;
+        if (!llvm::isa<llvm::StructType>(gep->getSourceElementType())) continue;
+
+        auto* accessType = getTBAATypeNode(gep->getResultElementType());
+        if (!accessType) continue;
+
+        instruction.setMetadata(llvm::LLVMContext::MD_tbaa, mdBuilder.createTBAAStructTagNode(accessType, accessType, 0));
+    }
+}
+
+/// Returns null for types that can't be described to TBAA, e.g. aggregates.
+llvm::MDNode* IRGenerator::getTBAATypeNode(llvm::Type* type) {
+    llvm::MDBuilder mdBuilder(ctx);
+    // Like char in C, byte-sized types may be used to access the bytes of any other type.
+    auto* charType = mdBuilder.createTBAAScalarTypeNode("omnipotent char", mdBuilder.createTBAARoot("Delta TBAA"));
+
+    if (type->isIntegerTy()) {
+        if (type->getIntegerBitWidth() <= 8) return charType;
+        // Signed and unsigned integers of the same size share a type, since they may be cast to each other.
+        return mdBuilder.createTBAAScalarTypeNode("int" + std::to_string(type->getIntegerBitWidth()), charType);
+    }
+
+    if (type->isFloatTy()) return mdBuilder.createTBAAScalarTypeNode("float32", charType);
+    if (type->isDoubleTy()) return mdBuilder.createTBAAScalarTypeNode("float64", charType);
+    if (type->isPointerTy()) return mdBuilder.createTBAAScalarTypeNode("pointer", charType);
+    return nullptr;
+}
+
+/// Returns the method of the standard library's List that accesses an element without a bounds check, if the given
+/// subscript operator is List's.
+static const MethodDecl* getUncheckedSubscript(const MethodDecl& subscriptDecl) {
+    auto* typeDecl = subscriptDecl.getTypeDecl();
+    if (typeDecl->getName() != "List" || !typeDecl->getModule() || typeDecl->getModule()->getName() != "std") return nullptr;
+
+    for (auto* memberDecl : typeDecl->getMemberDecls()) {
+        auto* methodDecl = llvm::dyn_cast<MethodDecl>(memberDecl);
+        if (methodDecl && methodDecl->getName() == "uncheckedSubscript") return methodDecl;
+    }
+
+    return nullptr;
+}
+
 llvm::Value* IRGenerator::getFunctionForCall(const CallExpr& call) {
     if (!call.callsNamedFunction()) {
         ERROR(call.getLocation(), "anonymous function calls not implemented yet");
@@ -280,8 +346,16 @@ llvm::Value* IRGenerator::getFunctionForCall(const CallExpr& call) {
     if (!decl) return nullptr;
 
     switch (decl->getKind()) {
-        case DeclKind::FunctionDecl:
         case DeclKind::MethodDecl:
+            if (auto* subscriptExpr = llvm::dyn_cast<SubscriptExpr>(&call)) {
+                if (unchecked || subscriptExpr->isIndexInBounds()) {
+                    if (auto* uncheckedSubscript = getUncheckedSubscript(*llvm::cast<MethodDecl>(decl))) {
+                        return getFunctionProto(*uncheckedSubscript);
+                    }
+                }
+            }
+            LLVM_FALLTHROUGH;
+        case DeclKind::FunctionDecl:
         case DeclKind::InitDecl:
         case DeclKind::DeinitDecl:
             return getFunctionProto(*llvm::cast<FunctionDecl>(decl));
@@ -300,9 +374,50 @@ llvm::Value* IRGenerator::getFunctionForCall(const CallExpr& call) {
     }
 }
 
+/// Returns true if code from the source file may be instantiated into other modules, e.g. the methods of a type
+/// template. Such code may reference the private declarations of the file from other modules.
+static bool hasCodeInstantiatedInOtherModules(const SourceFile& sourceFile) {
+    for (auto* decl : sourceFile.getTopLevelDecls()) {
+        if (decl->isFunctionTemplate() || decl->isTypeTemplate()) return true;
+
+        if (auto* typeDecl = llvm::dyn_cast<TypeDecl>(decl)) {
+            // The default method implementations of interfaces are copied into the types implementing them.
+            if (typeDecl->isInterface()) return true;
+            if (llvm::any_of(typeDecl->getMemberDecls(), [](Decl* member) { return member->isFunctionTemplate(); })) return true;
+        }
+    }
+
+    return false;
+}
+
+/// Collects the private functions of the module that can't be referenced from other modules, which are given internal
+/// linkage so that they can be removed if unused and aren't visible to the linker.
+void IRGenerator::collectInternalFunctions(const Module& sourceModule) {
+    auto addIfPrivate = [&](Decl* decl) {
+        auto* functionDecl = llvm::dyn_cast<FunctionDecl>(decl);
+        if (functionDecl && functionDecl->getAccessLevel() == AccessLevel::Private && !functionDecl->isExtern()) {
+            internalFunctions.insert(functionDecl);
+        }
+    };
+
+    for (const auto& sourceFile : sourceModule.getSourceFiles()) {
+        if (hasCodeInstantiatedInOtherModules(sourceFile)) continue;
+
+        for (auto* decl : sourceFile.getTopLevelDecls()) {
+            if (auto* typeDecl = llvm::dyn_cast<TypeDecl>(decl)) {
+                llvm::for_each(typeDecl->getMemberDecls(), addIfPrivate);
+            } else {
+                addIfPrivate(decl);
+            }
+        }
+    }
+}
+
 llvm::Module& IRGenerator::codegenModule(const Module& sourceModule) {
     ASSERT(!module);
+    PhaseTimer timer("IR generation", sourceModule.getName());
     module = new llvm::Module(sourceModule.getName(), ctx);
+    collectInternalFunctions(sourceModule);
 
     for (const auto& sourceFile : sourceModule.getSourceFiles()) {
         for (const auto& decl : sourceFile.getTopLevelDecls()) {
@@ -310,22 +425,39 @@ llvm::Module& IRGenerator::codegenModule(const Module& sourceModule) {
         }
     }
 
-    while (true) {
-        auto currentFunctionInstantiations = functionInstantiations;
-
-        for (auto& p : currentFunctionInstantiations) {
-            if (p.second.getDecl().isExtern() || !p.second.getFunction()->empty()) continue;
-
-            currentDecl = &p.second.getDecl();
-            codegenFunctionBody(p.second.getDecl(), *p.second.getFunction());
-            ASSERT(!llvm::verifyFunction(*p.second.getFunction(), &llvm::errs()));
+    // Generating the body of a function may reference new functions, which are generated in the next round.
+    // Each round is sorted by mangled name, so that the output doesn't depend on the order of the references.
+    while (!pendingInstantiations.empty()) {
+        auto instantiations = std::move(pendingInstantiations);
+        pendingInstantiations.clear();
+        llvm::sort(instantiations, [](const FunctionInstantiation* a, const FunctionInstantiation* b) {
+            return a->getFunction()->getName() < b->getFunction()->getName();
+        });
+
+        for (auto* instantiation : instantiations) {
+            auto& function = *instantiation->getFunction();
+            if (!function.empty()) continue;
+
+            currentDecl = &instantiation->getDecl();
+            codegenFunctionBody(instantiation->getDecl(), function);
+            ASSERT(!llvm::verifyFunction(function, &llvm::errs()));
         }
-
-        if (functionInstantiations.size() == currentFunctionInstantiations.size()) break;
     }
 
     ASSERT(!llvm::verifyModule(*module, &llvm::errs()));
+    addToStatistic(Statistic::InstructionsGenerated, module->getInstructionCount());
     generatedModules.push_back(module);
     module = nullptr;
+    stringRefLiterals.clear();
     return *generatedModules.back();
 }
+
+void IRGenerator::addPrecompiledModule(std::unique_ptr<llvm::Module> precompiledModule) {
+    ASSERT(!module);
+
+    for (auto& function : *precompiledModule) {
+        if (!function.isDeclaration()) precompiledFunctions.insert(function.getName());
+    }
+
+    generatedModules.push_back(precompiledModule.release());
+}
@@ -1,10 +1,12 @@
 #pragma once
 
-#include <map>
+#include <memory>
 #include <vector>
 #pragma warning(push, 0)
 #include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
 #include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/StringSet.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Module.h>
 #pragma warning(pop)
@@ -41,6 +43,15 @@ class IRGenerator {
 public:
     IRGenerator();
     llvm::Module& codegenModule(const Module& sourceModule);
+    /// Adds a previously generated module in place of calling codegenModule. Functions defined by it
+    /// are only declared, not redefined, by subsequently generated modules.
+    void addPrecompiledModule(std::unique_ptr<llvm::Module> precompiledModule);
+    /// Annotates the generated IR with function attributes and TBAA metadata derived from the Delta types.
+    /// They're only useful to the optimizer, so they're omitted at -O0 to keep the IR minimal.
+    void enableOptimizationHints() { emitOptimizationHints = true; }
+    /// Omits runtime checks: assertions, null checks of unwrapped optionals, and List index bounds checks.
+    void enableUncheckedMode() { unchecked = true; }
+    llvm::Module& getLastGeneratedModule() { return *generatedModules.back(); }
     llvm::LLVMContext& getLLVMContext() { return ctx; }
     std::vector<llvm::Module*> getGeneratedModules() { return std::move(generatedModules); }
 
@@ -67,6 +78,7 @@ private:
     llvm::Value* codegenAutoCast(llvm::Value* value, const Expr& expr);
     llvm::Value* codegenVarExpr(const VarExpr& expr);
     llvm::Value* codegenStringLiteralExpr(const StringLiteralExpr& expr);
+    llvm::GlobalVariable* getStringRefLiteral(llvm::StringRef value);
     llvm::Value* codegenCharacterLiteralExpr(const CharacterLiteralExpr& expr);
     llvm::Value* codegenIntLiteralExpr(const IntLiteralExpr& expr);
     llvm::Value* codegenFloatLiteralExpr(const FloatLiteralExpr& expr);
@@ -122,6 +134,11 @@ private:
 
     llvm::Value* getFunctionForCall(const CallExpr& call);
     llvm::Function* getFunctionProto(const FunctionDecl& decl);
+    llvm::GlobalValue::LinkageTypes getFunctionLinkage(const FunctionDecl& decl) const;
+    void addFunctionAttributes(const FunctionDecl& decl, llvm::Function& function);
+    void addTBAAMetadata(llvm::Function& function);
+    llvm::MDNode* getTBAATypeNode(llvm::Type* type);
+    void collectInternalFunctions(const Module& sourceModule);
     llvm::AllocaInst* createEntryBlockAlloca(llvm::Type* type, llvm::Value* arraySize = nullptr, const llvm::Twine& name = "");
     llvm::AllocaInst* createTempAlloca(llvm::Value* value, const llvm::Twine& name = "");
     llvm::Value* createLoad(llvm::Value* value);
@@ -160,8 +177,17 @@ private:
     std::vector<llvm::Module*> generatedModules;
     llvm::BasicBlock::iterator lastAlloca;
 
-    std::map<std::string, FunctionInstantiation> functionInstantiations;
+    llvm::StringMap<FunctionInstantiation> functionInstantiations;
+    /// Instantiations whose body hasn't been generated yet.
+    std::vector<FunctionInstantiation*> pendingInstantiations;
+    /// Functions that can only be referenced from the module that defines them, see collectInternalFunctions().
+    llvm::DenseSet<const FunctionDecl*> internalFunctions;
+    /// The StringRef literals of the current module, see getStringRefLiteral().
+    llvm::StringMap<llvm::GlobalVariable*> stringRefLiterals;
+    llvm::StringSet<> precompiledFunctions;
     llvm::StringMap<std::pair<llvm::StructType*, const TypeDecl*>> structs;
+    bool emitOptimizationHints = false;
+    bool unchecked = false;
     const Decl* currentDecl;
 
     /// The basic blocks to branch to on a 'break'/'continue' statement.
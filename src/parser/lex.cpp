@@ -1,100 +1,109 @@
 #include "lex.h"
+#include <array>
 #include <cctype>
+#include <cstring>
 #include <string>
 #include <vector>
 #pragma warning(push, 0)
-#include <llvm/ADT/StringMap.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/ErrorHandling.h>
 #include <llvm/Support/MemoryBuffer.h>
 #pragma warning(pop)
 #include "parse.h"
 #include "../ast/token.h"
+#include "../support/statistics.h"
 #include "../support/utility.h"
 
 using namespace delta;
 
 std::vector<llvm::MemoryBuffer*> Lexer::fileBuffers;
 
-Lexer::Lexer(llvm::MemoryBuffer* input)
-: firstLocation(input->getBufferIdentifier().data(), 1, 0), lastLocation(input->getBufferIdentifier().data(), 1, 0) {
+Lexer::Lexer(llvm::MemoryBuffer* input) : bufferStartLocation(SourceManager::addBuffer(*input)) {
     fileBuffers.push_back(input);
     currentFilePosition = fileBuffers.back()->getBufferStart() - 1;
+    tokenStart = currentFilePosition;
+}
+
+Lexer::~Lexer() {
+    addToStatistic(Statistic::TokensLexed, tokenCount);
 }
 
 const char* Lexer::getFilePath() const {
     return fileBuffers.back()->getBufferIdentifier().data();
 }
 
+const char* Lexer::getCharacterData(SourceLocation location) const {
+    return fileBuffers.back()->getBufferStart() + (location.getOffset() - bufferStartLocation.getOffset());
+}
+
+SourceLocation Lexer::getLocation(const char* position) const {
+    return bufferStartLocation.getLocationWithOffset(int32_t(position - fileBuffers.back()->getBufferStart()));
+}
+
 SourceLocation Lexer::getCurrentLocation() const {
-    return SourceLocation(getFilePath(), firstLocation.line, firstLocation.column);
+    return getLocation(tokenStart);
 }
 
 char Lexer::readChar() {
-    char ch = *++currentFilePosition;
-    if (ch != '\n') {
-        lastLocation.column++;
-    } else {
-        lastLocation.line++;
-        lastLocation.column = 0;
-    }
-    return ch;
+    return *++currentFilePosition;
 }
 
-void Lexer::unreadChar(char ch) {
-    if (ch != '\n') {
-        lastLocation.column--;
-    } else {
-        lastLocation.line--;
-        // lastLocation.column can be left as is because the next readChar() call will reset it anyways.
-    }
+void Lexer::unreadChar() {
     currentFilePosition--;
 }
 
 void Lexer::readBlockComment(SourceLocation startLocation) {
+    const char* position = currentFilePosition + 1;
     int nestLevel = 1;
 
     while (true) {
-        char ch = readChar();
-
-        if (ch == '*') {
-            char next = readChar();
-
-            if (next == '/') {
-                nestLevel--;
-                if (nestLevel == 0) return;
-            } else {
-                unreadChar(next);
-            }
-        } else if (ch == '/') {
-            char next = readChar();
+        // Jump directly to the next character that can open or close a comment.
+        position = std::strpbrk(position, "*/");
 
-            if (next == '*') {
-                nestLevel++;
-            } else {
-                unreadChar(next);
-            }
-        } else if (ch == '\0') {
+        if (!position) {
             ERROR(startLocation, "unterminated block comment");
         }
+
+        if (position[0] == '*' && position[1] == '/') {
+            position += 2;
+            nestLevel--;
+            if (nestLevel == 0) break;
+        } else if (position[0] == '/' && position[1] == '*') {
+            position += 2;
+            nestLevel++;
+        } else {
+            position++;
+        }
     }
+
+    currentFilePosition = position - 1;
 }
 
 Token Lexer::readQuotedLiteral(char delimiter, Token::Kind literalKind) {
     const char* begin = currentFilePosition;
-    const char* end = begin + 2;
-    int ch;
-
-    while ((ch = readChar()) != delimiter || *(end - 2) == '\\') {
-        if (ch == '\n' || ch == '\r') {
-            SourceLocation newlineLocation = firstLocation;
-            newlineLocation.column += end - begin - 1;
-            ERROR(newlineLocation, "newline inside " << toString(literalKind));
+    const char* position = begin + 1;
+    const char specialCharacters[] = { delimiter, '\\', '\n', '\r', '\0' };
+
+    while (true) {
+        position += std::strcspn(position, specialCharacters);
+
+        switch (*position) {
+            case '\\':
+                // A backslash doesn't escape a newline, which is reported as an error on the next iteration.
+                if (position[1] != '\0' && position[1] != '\n' && position[1] != '\r') position++;
+                position++;
+                continue;
+            case '\n':
+            case '\r':
+                ERROR(getLocation(position), "newline inside " << toString(literalKind));
+            case '\0':
+                ERROR(getCurrentLocation(), "unterminated " << toString(literalKind));
         }
-        end++;
+        break;
     }
 
-    return Token(literalKind, getCurrentLocation(), llvm::StringRef(begin, end - begin));
+    currentFilePosition = position;
+    return Token(literalKind, getCurrentLocation(), llvm::StringRef(begin, position + 1 - begin));
 }
 
 Token Lexer::readNumber() {
@@ -113,8 +122,8 @@ Token Lexer::readNumber() {
                     end++;
                     continue;
                 }
-                if (std::isalnum(ch)) ERROR(lastLocation, "invalid digit '" << ch << "' in binary literal");
-                if (end == begin + 2) ERROR(firstLocation, "binary literal must have at least one digit after '0b'");
+                if (std::isalnum(ch)) ERROR(getLocation(currentFilePosition), "invalid digit '" << ch << "' in binary literal");
+                if (end == begin + 2) ERROR(getCurrentLocation(), "binary literal must have at least one digit after '0b'");
                 goto end;
             }
             break;
@@ -127,14 +136,14 @@ Token Lexer::readNumber() {
                     end++;
                     continue;
                 }
-                if (std::isalnum(ch)) ERROR(lastLocation, "invalid digit '" << ch << "' in octal literal");
-                if (end == begin + 2) ERROR(firstLocation, "octal literal must have at least one digit after '0o'");
+                if (std::isalnum(ch)) ERROR(getLocation(currentFilePosition), "invalid digit '" << ch << "' in octal literal");
+                if (end == begin + 2) ERROR(getCurrentLocation(), "octal literal must have at least one digit after '0o'");
                 goto end;
             }
             break;
         default:
             if (std::isdigit(ch) && begin[0] == '0') {
-                ERROR(firstLocation, "numbers cannot start with 0[0-9], use 0o prefix for octal literal");
+                ERROR(getCurrentLocation(), "numbers cannot start with 0[0-9], use 0o prefix for octal literal");
             }
 
             while (true) {
@@ -158,16 +167,16 @@ Token Lexer::readNumber() {
                 if (std::isdigit(ch)) {
                     end++;
                 } else if (ch >= 'a' && ch <= 'f') {
-                    if (lettercase > 0) ERROR(lastLocation, "mixed letter case in hex literal");
+                    if (lettercase > 0) ERROR(getLocation(currentFilePosition), "mixed letter case in hex literal");
                     end++;
                     lettercase = -1;
                 } else if (ch >= 'A' && ch <= 'F') {
-                    if (lettercase < 0) ERROR(lastLocation, "mixed letter case in hex literal");
+                    if (lettercase < 0) ERROR(getLocation(currentFilePosition), "mixed letter case in hex literal");
                     end++;
                     lettercase = 1;
                 } else {
-                    if (std::isalnum(ch)) ERROR(lastLocation, "invalid digit '" << ch << "' in hex literal");
-                    if (end == begin + 2) ERROR(firstLocation, "hex literal must have at least one digit after '0x'");
+                    if (std::isalnum(ch)) ERROR(getLocation(currentFilePosition), "invalid digit '" << ch << "' in hex literal");
+                    if (end == begin + 2) ERROR(getCurrentLocation(), "hex literal must have at least one digit after '0x'");
                     goto end;
                 }
             }
@@ -175,11 +184,11 @@ Token Lexer::readNumber() {
     }
 
 end:
-    unreadChar(ch);
+    unreadChar();
 
     ASSERT(begin != end);
     if (end[-1] == '.') {
-        unreadChar('.'); // Lex the '.' as a Token::Dot.
+        unreadChar(); // Lex the '.' as a Token::Dot.
         isFloat = false;
         end--;
     }
@@ -187,7 +196,38 @@ end:
     return Token(isFloat ? Token::FloatLiteral : Token::IntegerLiteral, getCurrentLocation(), llvm::StringRef(begin, end - begin));
 }
 
-static const llvm::StringMap<Token::Kind> keywords = {
+namespace {
+
+enum CharacterClass : uint8_t {
+    Whitespace = 1 << 0,
+    IdentifierStart = 1 << 1,
+    IdentifierContinue = 1 << 2,
+};
+
+struct CharacterClassTable {
+    uint8_t classes[256] = {};
+
+    CharacterClassTable() {
+        for (unsigned char ch : { ' ', '\t', '\r', '\n' }) {
+            classes[ch] = Whitespace;
+        }
+        for (int ch = 0; ch < 256; ++ch) {
+            if (std::isalpha(ch) || ch == '_') classes[ch] = IdentifierStart | IdentifierContinue;
+            if (std::isdigit(ch)) classes[ch] = IdentifierContinue;
+        }
+        classes[uint8_t('#')] = IdentifierStart;
+    }
+};
+
+} // namespace
+
+static const CharacterClassTable characterClasses;
+
+static bool hasCharacterClass(char ch, CharacterClass characterClass) {
+    return characterClasses.classes[uint8_t(ch)] & characterClass;
+}
+
+static const std::pair<llvm::StringRef, Token::Kind> keywords[] = {
     { "addressof", Token::Addressof }, { "as", Token::As },         { "break", Token::Break },
     { "case", Token::Case },           { "const", Token::Const },   { "continue", Token::Continue },
     { "default", Token::Default },     { "defer", Token::Defer },   { "deinit", Token::Deinit },
@@ -202,33 +242,62 @@ static const llvm::StringMap<Token::Kind> keywords = {
     { "#endif", Token::HashEndif },
 };
 
-Token Lexer::nextToken() {
+/// Perfect hash function for the keywords above: each keyword maps to a different slot, so a lookup
+/// only needs to compare the identifier against a single candidate. Must be updated if keywords are added.
+static unsigned getKeywordHash(llvm::StringRef string) {
+    unsigned second = string.size() > 1 ? uint8_t(string[1]) : 0;
+    return (uint8_t(string[0]) * 27 + second + uint8_t(string.back()) * 44 + unsigned(string.size()) * 19) % 64;
+}
+
+static const auto keywordTable = [] {
+    std::array<std::pair<llvm::StringRef, Token::Kind>, 64> table = {};
+
+    for (auto& keyword : keywords) {
+        auto& slot = table[getKeywordHash(keyword.first)];
+        ASSERT(slot.first.empty(), "keyword hash collision");
+        slot = keyword;
+    }
+
+    return table;
+}();
+
+static Token::Kind getIdentifierKind(llvm::StringRef string) {
+    auto& slot = keywordTable[getKeywordHash(string)];
+    return slot.first == string ? slot.second : Token::Identifier;
+}
+
+Token Lexer::lexToken() {
     while (true) {
         char ch = readChar();
-        firstLocation.line = lastLocation.line;
-        firstLocation.column = lastLocation.column;
+        tokenStart = currentFilePosition;
 
         switch (ch) {
             case ' ':
             case '\t':
             case '\r':
             case '\n':
-                break; // skip whitespace
+                // Skip the whole run of whitespace without going back through the switch for each character.
+                while (hasCharacterClass(currentFilePosition[1], Whitespace)) {
+                    currentFilePosition++;
+                }
+                break;
             case '/':
                 ch = readChar();
                 if (ch == '/') {
                     // comment until end of line
-                    while (true) {
-                        char ch = readChar();
-                        if (ch == '\n') break;
-                        if (ch == '\0') goto end;
+                    auto* bufferEnd = fileBuffers.back()->getBufferEnd();
+                    auto* newline = static_cast<const char*>(std::memchr(currentFilePosition, '\n', bufferEnd - currentFilePosition));
+                    if (!newline) {
+                        currentFilePosition = bufferEnd - 1;
+                        goto end;
                     }
+                    currentFilePosition = newline;
                 } else if (ch == '*') {
-                    readBlockComment(firstLocation);
+                    readBlockComment(getCurrentLocation());
                 } else if (ch == '=') {
                     return Token(Token::SlashEqual, getCurrentLocation());
                 } else {
-                    unreadChar(ch);
+                    unreadChar();
                     return Token(Token::Slash, getCurrentLocation());
                 }
                 break;
@@ -236,24 +305,24 @@ Token Lexer::nextToken() {
                 ch = readChar();
                 if (ch == '+') return Token(Token::Increment, getCurrentLocation());
                 if (ch == '=') return Token(Token::PlusEqual, getCurrentLocation());
-                unreadChar(ch);
+                unreadChar();
                 return Token(Token::Plus, getCurrentLocation());
             case '-':
                 ch = readChar();
                 if (ch == '-') return Token(Token::Decrement, getCurrentLocation());
                 if (ch == '>') return Token(Token::RightArrow, getCurrentLocation());
                 if (ch == '=') return Token(Token::MinusEqual, getCurrentLocation());
-                unreadChar(ch);
+                unreadChar();
                 return Token(Token::Minus, getCurrentLocation());
             case '*':
                 ch = readChar();
                 if (ch == '=') return Token(Token::StarEqual, getCurrentLocation());
-                unreadChar(ch);
+                unreadChar();
                 return Token(Token::Star, getCurrentLocation());
             case '%':
                 ch = readChar();
                 if (ch == '=') return Token(Token::ModuloEqual, getCurrentLocation());
-                unreadChar(ch);
+                unreadChar();
                 return Token(Token::Modulo, getCurrentLocation());
             case '<':
                 ch = readChar();
@@ -261,10 +330,10 @@ Token Lexer::nextToken() {
                 if (ch == '<') {
                     ch = readChar();
                     if (ch == '=') return Token(Token::LeftShiftEqual, getCurrentLocation());
-                    unreadChar(ch);
+                    unreadChar();
                     return Token(Token::LeftShift, getCurrentLocation());
                 }
-                unreadChar(ch);
+                unreadChar();
                 return Token(Token::Less, getCurrentLocation());
             case '>':
                 ch = readChar();
@@ -272,57 +341,57 @@ Token Lexer::nextToken() {
                 if (ch == '>') {
                     ch = readChar();
                     if (ch == '=') return Token(Token::RightShiftEqual, getCurrentLocation());
-                    unreadChar(ch);
+                    unreadChar();
                     return Token(Token::RightShift, getCurrentLocation());
                 }
-                unreadChar(ch);
+                unreadChar();
                 return Token(Token::Greater, getCurrentLocation());
             case '=':
                 ch = readChar();
                 if (ch == '=') {
                     ch = readChar();
                     if (ch == '=') return Token(Token::PointerEqual, getCurrentLocation());
-                    unreadChar(ch);
+                    unreadChar();
                     return Token(Token::Equal, getCurrentLocation());
                 }
-                unreadChar(ch);
+                unreadChar();
                 return Token(Token::Assignment, getCurrentLocation());
             case '!':
                 ch = readChar();
                 if (ch == '=') {
                     ch = readChar();
                     if (ch == '=') return Token(Token::PointerNotEqual, getCurrentLocation());
-                    unreadChar(ch);
+                    unreadChar();
                     return Token(Token::NotEqual, getCurrentLocation());
                 }
-                unreadChar(ch);
+                unreadChar();
                 return Token(Token::Not, getCurrentLocation());
             case '&':
                 ch = readChar();
                 if (ch == '&') {
                     ch = readChar();
                     if (ch == '=') return Token(Token::AndAndEqual, getCurrentLocation());
-                    unreadChar(ch);
+                    unreadChar();
                     return Token(Token::AndAnd, getCurrentLocation());
                 }
                 if (ch == '=') return Token(Token::AndEqual, getCurrentLocation());
-                unreadChar(ch);
+                unreadChar();
                 return Token(Token::And, getCurrentLocation());
             case '|':
                 ch = readChar();
                 if (ch == '|') {
                     ch = readChar();
                     if (ch == '=') return Token(Token::OrOrEqual, getCurrentLocation());
-                    unreadChar(ch);
+                    unreadChar();
                     return Token(Token::OrOr, getCurrentLocation());
                 }
                 if (ch == '=') return Token(Token::OrEqual, getCurrentLocation());
-                unreadChar(ch);
+                unreadChar();
                 return Token(Token::Or, getCurrentLocation());
             case '^':
                 ch = readChar();
                 if (ch == '=') return Token(Token::XorEqual, getCurrentLocation());
-                unreadChar(ch);
+                unreadChar();
                 return Token(Token::Xor, getCurrentLocation());
             case '~':
                 return Token(Token::Tilde, getCurrentLocation());
@@ -343,10 +412,10 @@ Token Lexer::nextToken() {
                 if (ch == '.') {
                     char ch = readChar();
                     if (ch == '.') return Token(Token::DotDotDot, getCurrentLocation());
-                    unreadChar(ch);
+                    unreadChar();
                     return Token(Token::DotDot, getCurrentLocation());
                 }
-                unreadChar(ch);
+                unreadChar();
                 return Token(Token::Dot, getCurrentLocation());
             case ',':
                 return Token(Token::Comma, getCurrentLocation());
@@ -365,25 +434,18 @@ Token Lexer::nextToken() {
             default:
                 if (std::isdigit(ch)) return readNumber();
 
-                if (!std::isalpha(ch) && ch != '_' && ch != '#') {
-                    ERROR(firstLocation, "unknown token '" << (char) ch << "'");
+                if (!hasCharacterClass(ch, IdentifierStart)) {
+                    ERROR(getCurrentLocation(), "unknown token '" << (char) ch << "'");
                 }
 
-                const char* begin = currentFilePosition;
-                const char* end = begin;
-                do {
+                const char* end = currentFilePosition + 1;
+                while (hasCharacterClass(*end, IdentifierContinue)) {
                     end++;
-                } while (std::isalnum(ch = readChar()) || ch == '_');
-                unreadChar(ch);
-
-                llvm::StringRef string(begin, end - begin);
-
-                auto it = keywords.find(string);
-                if (it != keywords.end()) {
-                    return Token(it->second, getCurrentLocation(), string);
                 }
+                currentFilePosition = end - 1;
 
-                return Token(Token::Identifier, getCurrentLocation(), string);
+                llvm::StringRef string(tokenStart, end - tokenStart);
+                return Token(getIdentifierKind(string), getCurrentLocation(), string);
         }
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include "../ast/token.h"
 
@@ -14,22 +15,32 @@ struct SourceLocation;
 class Lexer {
 public:
     Lexer(llvm::MemoryBuffer* input);
-    Token nextToken();
+    ~Lexer();
+    Token nextToken() {
+        tokenCount++;
+        return lexToken();
+    }
     const char* getFilePath() const;
+    /// Returns a pointer to the character at the given location, which must be in the buffer being lexed. Unlike
+    /// SourceManager::getCharacterData(), this doesn't need to search the buffers or take a lock.
+    const char* getCharacterData(SourceLocation location) const;
 
     static std::vector<llvm::MemoryBuffer*> fileBuffers; // TODO: Make this non-static.
 
 private:
+    Token lexToken();
+    SourceLocation getLocation(const char* position) const;
     SourceLocation getCurrentLocation() const;
     char readChar();
-    void unreadChar(char ch);
+    void unreadChar();
     void readBlockComment(SourceLocation startLocation);
     Token readQuotedLiteral(char delimiter, Token::Kind literalKind);
     Token readNumber();
 
     const char* currentFilePosition;
-    SourceLocation firstLocation;
-    SourceLocation lastLocation;
+    const char* tokenStart;
+    SourceLocation bufferStartLocation;
+    uint64_t tokenCount = 0;
 };
 
 } // namespace delta
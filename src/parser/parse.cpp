@@ -15,6 +15,7 @@
 #include "../ast/module.h"
 #include "../ast/token.h"
 #include "../driver/driver.h"
+#include "../support/statistics.h"
 #include "../support/utility.h"
 
 using namespace delta;
@@ -125,20 +126,17 @@ void Parser::checkStmtTerminatorConsistency(Token::Kind currentTerminator, llvm:
     }
 }
 
-bool isNewline(char ch) {
-    return ch == '\n';
-}
-
 void Parser::parseStmtTerminator(const char* contextInfo) {
-    if (getCurrentLocation().line != lookAhead(-1).getLocation().line) {
-        checkStmtTerminatorConsistency(Token::Newline, [this] {
-            auto source = getCurrentSource();
-            auto line = lookAhead(-1).getLocation().line;
-            while (--line) {
-                source = source.drop_until(isNewline).drop_front();
-            }
-            auto column = source.find_first_of("\r\n") + 1;
-            return SourceLocation(getCurrentLocation().file, lookAhead(-1).getLocation().line, static_cast<SourceLocation::IntegerType>(column));
+    auto previousToken = lookAhead(-1);
+    auto previousTokenLocation = previousToken.getLocation();
+    auto* previousTokenData = previousToken == Token::None ? nullptr : lexer.getCharacterData(previousTokenLocation);
+    auto* currentTokenData = lexer.getCharacterData(getCurrentLocation());
+
+    if (previousTokenData && llvm::StringRef(previousTokenData, currentTokenData - previousTokenData).contains('\n')) {
+        checkStmtTerminatorConsistency(Token::Newline, [&] {
+            // Point to the end of the line containing the previous token.
+            auto column = llvm::StringRef(previousTokenData).find_first_of("\r\n");
+            return previousTokenLocation.getLocationWithOffset(int32_t(column));
         });
         return;
     }
@@ -156,10 +154,6 @@ void Parser::parseStmtTerminator(const char* contextInfo) {
     }
 }
 
-llvm::StringRef Parser::getCurrentSource() const {
-    return Lexer::fileBuffers.back()->getBuffer();
-}
-
 /// argument-list ::= '(' ')' | '(' nonempty-argument-list ')'
 /// nonempty-argument-list ::= argument | nonempty-argument-list ',' argument
 /// argument ::= (id ':')? expr
@@ -238,8 +232,7 @@ static std::string replaceEscapeChars(llvm::StringRef literalContent, SourceLoca
                     result += '\\';
                     break;
                 default:
-                    auto itColumn = literalStartLocation.column + 1 + (it - literalContent.begin());
-                    SourceLocation itLocation(literalStartLocation.file, literalStartLocation.line, itColumn);
+                    auto itLocation = literalStartLocation.getLocationWithOffset(int32_t(1 + (it - literalContent.begin())));
                     ERROR(itLocation, "unknown escape character '\\" << *it << "'");
             }
             continue;
@@ -351,7 +344,7 @@ std::vector<Type> Parser::parseNonEmptyTypeList() {
         } else {
             if (currentToken() == Token::RightShift) {
                 tokenBuffer[currentTokenIndex] = Token(Token::Greater, currentToken().getLocation());
-                tokenBuffer.insert(tokenBuffer.begin() + currentTokenIndex + 1, Token(Token::Greater, currentToken().getLocation().nextColumn()));
+                tokenBuffer.insert(tokenBuffer.begin() + currentTokenIndex + 1, Token(Token::Greater, currentToken().getLocation().getLocationWithOffset(1)));
             }
             return types;
         }
@@ -613,8 +606,8 @@ bool Parser::shouldParseGenericArgumentList() {
     // Temporary hack: use spacing to determine whether to parse a generic argument list
     // of a less-than binary expression. Zero spaces on either side of '<' will cause it
     // to be interpreted as a generic argument list, for now.
-    return lookAhead(0).getLocation().column + int(lookAhead(0).getString().size()) == lookAhead(1).getLocation().column ||
-           lookAhead(1).getLocation().column + 1 == lookAhead(2).getLocation().column;
+    return lookAhead(0).getLocation().getOffset() + lookAhead(0).getString().size() == lookAhead(1).getLocation().getOffset() ||
+           lookAhead(1).getLocation().getOffset() + 1 == lookAhead(2).getLocation().getOffset();
 }
 
 /// Returns true if a right-arrow token immediately follows the current set of parentheses.
@@ -1504,6 +1497,8 @@ Decl* Parser::parseTopLevelFunctionOrVariable(bool isExtern, bool addToSymbolTab
 }
 
 void Parser::parse() {
+    // Tokens are lexed on demand while parsing, so this includes the lexing time.
+    PhaseTimer timer("Parsing", currentModule->getName());
     std::vector<Decl*> topLevelDecls;
     SourceFile sourceFile(lexer.getFilePath());
 
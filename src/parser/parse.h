@@ -164,7 +164,6 @@ private:
     void parseIfdef(std::vector<Decl*>* activeDecls);
     Decl* parseTopLevelDecl(bool addToSymbolTable);
     Decl* parseTopLevelFunctionOrVariable(bool isExtern, bool addToSymbolTable, AccessLevel accessLevel);
-    llvm::StringRef getCurrentSource() const;
     InitDecl* createAutogeneratedInitializer(TypeDecl* typeDecl) const;
 
 private:
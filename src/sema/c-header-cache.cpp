@@ -0,0 +1,470 @@
+#include "c-header-cache.h"
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+#include <vector>
+#pragma warning(push, 0)
+#include <llvm/ADT/APSInt.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+#pragma warning(pop)
+#include "../ast/decl.h"
+#include "../ast/expr.h"
+#include "../ast/module.h"
+#include "../ast/type.h"
+#include "../driver/driver.h"
+#include "../support/utility.h"
+
+using namespace delta;
+
+/// Must be changed whenever the format of the cache entries changes.
+static const char formatVersion[] = "delta-c-header-cache-1";
+
+namespace {
+
+enum class EntryKind : uint8_t { Function, Struct, Union, Enum, Variable, IntegerConstant, FloatConstant };
+
+class Writer {
+public:
+    Writer(llvm::raw_ostream& out) : out(out) {}
+
+    template<typename T>
+    void writeScalar(T value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void writeString(llvm::StringRef string) {
+        writeScalar<uint64_t>(string.size());
+        out << string;
+    }
+
+    void writeAPSInt(const llvm::APSInt& value) {
+        writeScalar<uint32_t>(value.getBitWidth());
+        writeScalar<uint8_t>(value.isUnsigned());
+        for (unsigned i = 0; i < value.getNumWords(); ++i) {
+            writeScalar<uint64_t>(value.getRawData()[i]);
+        }
+    }
+
+    void writeTypes(llvm::ArrayRef<Type> types) {
+        writeScalar<uint64_t>(types.size());
+        for (Type type : types) {
+            writeType(type);
+        }
+    }
+
+    void writeType(Type type) {
+        writeScalar<uint8_t>(static_cast<uint8_t>(type.getKind()));
+        writeScalar<uint8_t>(static_cast<uint8_t>(type.getMutability()));
+
+        switch (type.getKind()) {
+            case TypeKind::BasicType:
+                writeString(type.getName());
+                writeTypes(type.getGenericArgs());
+                break;
+            case TypeKind::ArrayType:
+                writeType(type.getElementType());
+                writeScalar<int64_t>(type.getArraySize());
+                break;
+            case TypeKind::TupleType:
+                writeScalar<uint64_t>(type.getTupleElements().size());
+                for (auto& element : type.getTupleElements()) {
+                    writeString(element.name);
+                    writeType(element.type);
+                }
+                break;
+            case TypeKind::FunctionType:
+                writeType(type.getReturnType());
+                writeTypes(type.getParamTypes());
+                break;
+            case TypeKind::PointerType:
+                writeType(type.getPointee());
+                break;
+            case TypeKind::OptionalType:
+                writeType(type.getWrappedType());
+                break;
+        }
+    }
+
+    void writeDecl(const Decl& decl) {
+        switch (decl.getKind()) {
+            case DeclKind::FunctionDecl: {
+                auto& functionDecl = llvm::cast<FunctionDecl>(decl);
+                writeScalar(EntryKind::Function);
+                writeString(functionDecl.getName());
+                writeType(functionDecl.getReturnType());
+                writeScalar<uint8_t>(functionDecl.isVariadic());
+                writeScalar<uint64_t>(functionDecl.getParams().size());
+                for (auto& param : functionDecl.getParams()) {
+                    writeString(param.getName());
+                    writeType(param.getType());
+                }
+                break;
+            }
+            case DeclKind::TypeDecl: {
+                auto& typeDecl = llvm::cast<TypeDecl>(decl);
+                writeScalar(typeDecl.isUnion() ? EntryKind::Union : EntryKind::Struct);
+                writeString(typeDecl.getName());
+                writeScalar<uint64_t>(typeDecl.getFields().size());
+                for (auto& field : typeDecl.getFields()) {
+                    writeString(field.getName());
+                    writeType(field.getType());
+                }
+                break;
+            }
+            case DeclKind::EnumDecl: {
+                auto& enumDecl = llvm::cast<EnumDecl>(decl);
+                writeScalar(EntryKind::Enum);
+                writeString(enumDecl.getName());
+                writeScalar<uint64_t>(enumDecl.getCases().size());
+                for (auto& enumCase : enumDecl.getCases()) {
+                    writeString(enumCase.getName());
+                    writeAPSInt(llvm::cast<IntLiteralExpr>(enumCase.getValue())->getValue());
+                }
+                break;
+            }
+            case DeclKind::VarDecl: {
+                auto& varDecl = llvm::cast<VarDecl>(decl);
+                auto* initializer = varDecl.getInitializer();
+
+                if (!initializer) {
+                    writeScalar(EntryKind::Variable);
+                } else if (llvm::isa<IntLiteralExpr>(initializer)) {
+                    writeScalar(EntryKind::IntegerConstant);
+                } else {
+                    writeScalar(EntryKind::FloatConstant);
+                }
+
+                writeString(varDecl.getName());
+                writeType(varDecl.getType());
+
+                if (auto* intLiteral = llvm::dyn_cast_or_null<IntLiteralExpr>(initializer)) {
+                    writeAPSInt(intLiteral->getValue());
+                } else if (auto* floatLiteral = llvm::dyn_cast_or_null<FloatLiteralExpr>(initializer)) {
+                    writeScalar(floatLiteral->getValue());
+                }
+                break;
+            }
+            default:
+                llvm_unreachable("unexpected declaration imported from C header");
+        }
+    }
+
+private:
+    llvm::raw_ostream& out;
+};
+
+/// Reads the data written by Writer. Reading past the end of the data or encountering invalid values
+/// sets the failed flag instead of crashing, since cache entries may be truncated or corrupted.
+class Reader {
+public:
+    Reader(llvm::StringRef data) : data(data), error(false) {}
+    bool failed() const { return error; }
+
+    template<typename T>
+    T readScalar() {
+        T value{};
+        if (data.size() < sizeof(T)) {
+            error = true;
+            return value;
+        }
+        std::memcpy(&value, data.data(), sizeof(T));
+        data = data.drop_front(sizeof(T));
+        return value;
+    }
+
+    /// Reads an element count, rejecting counts that couldn't possibly fit in the remaining data.
+    uint64_t readCount() {
+        auto count = readScalar<uint64_t>();
+        if (count > data.size()) error = true;
+        return error ? 0 : count;
+    }
+
+    std::string readString() {
+        auto size = readCount();
+        auto string = data.take_front(size);
+        data = data.drop_front(size);
+        return string.str();
+    }
+
+    llvm::APSInt readAPSInt() {
+        auto bitWidth = readScalar<uint32_t>();
+        bool isUnsigned = readScalar<uint8_t>();
+        if (error || bitWidth == 0 || bitWidth > data.size() * 8) {
+            error = true;
+            return llvm::APSInt();
+        }
+
+        std::vector<uint64_t> words((bitWidth + 63) / 64);
+        for (auto& word : words) {
+            word = readScalar<uint64_t>();
+        }
+        return llvm::APSInt(llvm::APInt(bitWidth, words), isUnsigned);
+    }
+
+    std::vector<Type> readTypes() {
+        std::vector<Type> types;
+        for (auto count = readCount(); count > 0 && !error; --count) {
+            types.push_back(readType());
+        }
+        return types;
+    }
+
+    Type readType() {
+        auto kind = static_cast<TypeKind>(readScalar<uint8_t>());
+        auto mutability = static_cast<Mutability>(readScalar<uint8_t>());
+        if (error) return Type();
+
+        switch (kind) {
+            case TypeKind::BasicType: {
+                auto name = readString();
+                auto genericArgs = readTypes();
+                if (error) return Type();
+                return BasicType::get(name, genericArgs, mutability);
+            }
+            case TypeKind::ArrayType: {
+                auto elementType = readType();
+                auto size = readScalar<int64_t>();
+                if (error) return Type();
+                return ArrayType::get(elementType, size, mutability);
+            }
+            case TypeKind::TupleType: {
+                std::vector<TupleElement> elements;
+                for (auto count = readCount(); count > 0 && !error; --count) {
+                    auto name = readString();
+                    elements.push_back({ std::move(name), readType() });
+                }
+                if (error) return Type();
+                return TupleType::get(std::move(elements), mutability);
+            }
+            case TypeKind::FunctionType: {
+                auto returnType = readType();
+                auto paramTypes = readTypes();
+                if (error) return Type();
+                return FunctionType::get(returnType, std::move(paramTypes), mutability);
+            }
+            case TypeKind::PointerType: {
+                auto pointeeType = readType();
+                if (error) return Type();
+                return PointerType::get(pointeeType, mutability);
+            }
+            case TypeKind::OptionalType: {
+                auto wrappedType = readType();
+                if (error) return Type();
+                return OptionalType::get(wrappedType, mutability);
+            }
+        }
+
+        error = true;
+        return Type();
+    }
+
+    Decl* readDecl(Module& module) {
+        auto kind = readScalar<EntryKind>();
+        auto name = readString();
+        if (error) return nullptr;
+
+        switch (kind) {
+            case EntryKind::Function: {
+                auto returnType = readType();
+                bool isVariadic = readScalar<uint8_t>();
+                std::vector<ParamDecl> params;
+                for (auto count = readCount(); count > 0 && !error; --count) {
+                    auto paramName = readString();
+                    params.emplace_back(readType(), std::move(paramName), SourceLocation());
+                }
+                if (error) return nullptr;
+                FunctionProto proto(std::move(name), std::move(params), returnType, isVariadic, true);
+                return new FunctionDecl(std::move(proto), {}, AccessLevel::Default, module, SourceLocation());
+            }
+            case EntryKind::Struct:
+            case EntryKind::Union: {
+                auto tag = kind == EntryKind::Union ? TypeTag::Union : TypeTag::Struct;
+                auto* typeDecl = new TypeDecl(tag, std::move(name), {}, {}, AccessLevel::Default, module, SourceLocation());
+                for (auto count = readCount(); count > 0 && !error; --count) {
+                    auto fieldName = readString();
+                    typeDecl->addField(FieldDecl(readType(), std::move(fieldName), *typeDecl, AccessLevel::Default, SourceLocation()));
+                }
+                return error ? nullptr : typeDecl;
+            }
+            case EntryKind::Enum: {
+                std::vector<EnumCase> cases;
+                for (auto count = readCount(); count > 0 && !error; --count) {
+                    auto caseName = readString();
+                    auto* value = new IntLiteralExpr(readAPSInt(), SourceLocation());
+                    cases.push_back(EnumCase(std::move(caseName), value, Type(), AccessLevel::Default, SourceLocation()));
+                }
+                if (error) return nullptr;
+                return new EnumDecl(std::move(name), std::move(cases), AccessLevel::Default, module, SourceLocation());
+            }
+            case EntryKind::Variable:
+            case EntryKind::IntegerConstant:
+            case EntryKind::FloatConstant: {
+                auto type = readType();
+                Expr* initializer = nullptr;
+
+                if (kind == EntryKind::IntegerConstant) {
+                    initializer = new IntLiteralExpr(readAPSInt(), SourceLocation());
+                } else if (kind == EntryKind::FloatConstant) {
+                    initializer = new FloatLiteralExpr(readScalar<long double>(), SourceLocation());
+                }
+
+                if (error) return nullptr;
+                if (initializer) initializer->setType(type);
+                return new VarDecl(type, std::move(name), initializer, nullptr, AccessLevel::Default, module, SourceLocation());
+            }
+        }
+
+        error = true;
+        return nullptr;
+    }
+
+private:
+    llvm::StringRef data;
+    bool error;
+};
+
+} // namespace
+
+static void hashStrings(llvm::MD5& hasher, llvm::ArrayRef<std::string> strings) {
+    for (auto& string : strings) {
+        hasher.update(string);
+        hasher.update(llvm::StringRef("", 1));
+    }
+    hasher.update("\n");
+}
+
+CHeaderCache::CHeaderCache(llvm::StringRef headerName, const CompileOptions& options) {
+    if (!options.useCaches) return;
+
+    llvm::SmallString<128> directory;
+    if (!llvm::sys::path::user_cache_directory(directory, "delta", "c-headers")) return;
+
+    llvm::MD5 hasher;
+    hasher.update(formatVersion);
+
+    // Identify the compiler version by the path, size, and modification time of its executable, since the declarations
+    // imported from a header depend on the Clang version and on how the compiler converts them.
+    auto compilerPath = llvm::sys::fs::getMainExecutable(nullptr, (void*) (intptr_t) &hashStrings);
+    llvm::sys::fs::file_status compilerStatus;
+    if (llvm::sys::fs::status(compilerPath, compilerStatus)) return;
+    hasher.update(compilerPath);
+    hasher.update(std::to_string(compilerStatus.getSize()));
+    hasher.update(std::to_string(compilerStatus.getLastModificationTime().time_since_epoch().count()));
+
+    hasher.update(llvm::sys::getDefaultTargetTriple());
+    hashStrings(hasher, headerName.str());
+    hashStrings(hasher, options.cflags);
+    hashStrings(hasher, options.importSearchPaths);
+    hashStrings(hasher, options.frameworkSearchPaths);
+
+    llvm::MD5::MD5Result result;
+    hasher.final(result);
+    llvm::sys::path::append(directory, result.digest());
+    entryPath = directory.str().str();
+}
+
+static void writeFileStatus(Writer& writer, const llvm::sys::fs::file_status& status) {
+    writer.writeScalar<uint64_t>(status.getSize());
+    writer.writeScalar<int64_t>(status.getLastModificationTime().time_since_epoch().count());
+}
+
+bool CHeaderCache::load(Module& module) const {
+    if (entryPath.empty()) return false;
+
+    auto buffer = llvm::MemoryBuffer::getFile(entryPath);
+    if (!buffer) return false;
+    Reader reader((*buffer)->getBuffer());
+
+    if (reader.readString() != formatVersion) return false;
+
+    // Check that none of the headers involved have changed since the entry was written.
+    std::vector<std::string> includedFiles;
+    for (auto count = reader.readCount(); count > 0 && !reader.failed(); --count) {
+        auto& path = includedFiles.emplace_back(reader.readString());
+        auto size = reader.readScalar<uint64_t>();
+        auto modificationTime = reader.readScalar<int64_t>();
+
+        llvm::sys::fs::file_status status;
+        if (reader.failed() || llvm::sys::fs::status(path, status)) return false;
+        if (status.getSize() != size || status.getLastModificationTime().time_since_epoch().count() != modificationTime) return false;
+    }
+
+    std::vector<std::pair<std::string, std::string>> identifierReplacements;
+    for (auto count = reader.readCount(); count > 0 && !reader.failed(); --count) {
+        auto source = reader.readString();
+        identifierReplacements.emplace_back(std::move(source), reader.readString());
+    }
+
+    std::vector<Decl*> decls;
+    for (auto count = reader.readCount(); count > 0 && !reader.failed(); --count) {
+        decls.push_back(reader.readDecl(module));
+    }
+
+    // Only modify the module once the whole entry has been read successfully.
+    if (reader.failed()) return false;
+
+    for (auto& replacement : identifierReplacements) {
+        module.addIdentifierReplacement(replacement.first, replacement.second);
+    }
+
+    for (auto* decl : decls) {
+        module.addToSymbolTable(decl);
+    }
+
+    module.setHeaderFiles(std::move(includedFiles));
+    return true;
+}
+
+void CHeaderCache::store(const Module& module, llvm::ArrayRef<std::string> includedFiles) const {
+    if (entryPath.empty()) return;
+    if (llvm::sys::fs::create_directories(llvm::sys::path::parent_path(entryPath))) return;
+
+    // Write to a temporary file first so that concurrent builds never see partially written entries.
+    llvm::SmallString<128> temporaryPath;
+    int fd;
+    if (llvm::sys::fs::createUniqueFile(entryPath + "-%%%%%%%%.tmp", fd, temporaryPath)) return;
+
+    {
+        llvm::raw_fd_ostream out(fd, true);
+        Writer writer(out);
+        writer.writeString(formatVersion);
+
+        writer.writeScalar<uint64_t>(includedFiles.size());
+        for (auto& path : includedFiles) {
+            llvm::sys::fs::file_status status;
+            llvm::sys::fs::status(path, status);
+            writer.writeString(path);
+            writeFileStatus(writer, status);
+        }
+
+        auto& symbolTable = module.getSymbolTable();
+
+        writer.writeScalar<uint64_t>(symbolTable.getIdentifierReplacements().size());
+        for (auto& replacement : symbolTable.getIdentifierReplacements()) {
+            writer.writeString(replacement.getKey());
+            writer.writeString(replacement.getValue());
+        }
+
+        uint64_t declCount = 0;
+        for (auto& entry : symbolTable.getGlobalScope().decls) {
+            declCount += entry.getValue().size();
+        }
+
+        writer.writeScalar(declCount);
+        for (auto& entry : symbolTable.getGlobalScope().decls) {
+            for (auto* decl : entry.getValue()) {
+                writer.writeDecl(*decl);
+            }
+        }
+    }
+
+    if (llvm::sys::fs::rename(temporaryPath, entryPath)) {
+        llvm::sys::fs::remove(temporaryPath);
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#pragma warning(push, 0)
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringRef.h>
+#pragma warning(pop)
+
+namespace delta {
+
+class Module;
+struct CompileOptions;
+
+/// Persistent per-user cache of the declarations imported from C headers, so that warm builds don't
+/// need to run the Clang preprocessor and parser on e.g. large system headers. Entries are keyed on
+/// the compiler binary, the header name, the cflags, and the search paths, and are invalidated when
+/// any file included while parsing the header (including the header itself) changes its modification
+/// time or size.
+class CHeaderCache {
+public:
+    CHeaderCache(llvm::StringRef headerName, const CompileOptions& options);
+    /// Returns true if an up-to-date entry was found, in which case its declarations were added to the module.
+    bool load(Module& module) const;
+    /// Stores the declarations of the module, which was imported from the given header files.
+    void store(const Module& module, llvm::ArrayRef<std::string> includedFiles) const;
+
+private:
+    std::string entryPath;
+};
+
+} // namespace delta
@@ -23,11 +23,13 @@
 #include <llvm/Support/Path.h>
 #include <llvm/Support/Program.h>
 #pragma warning(pop)
+#include "c-header-cache.h"
 #include "typecheck.h"
 #include "../ast/decl.h"
 #include "../ast/module.h"
 #include "../ast/type.h"
 #include "../driver/driver.h"
+#include "../support/statistics.h"
 #include "../support/utility.h"
 
 using namespace delta;
@@ -184,7 +186,7 @@ static TypeDecl* toDelta(const clang::RecordDecl& decl, Module* currentModule) {
 
     for (auto* field : decl.fields()) {
         if (auto fieldDecl = toDelta(*field, *typeDecl)) {
-            typeDecl->getFields().emplace_back(std::move(*fieldDecl));
+            typeDecl->addField(std::move(*fieldDecl));
         } else {
             return nullptr;
         }
@@ -320,7 +322,16 @@ bool delta::importCHeader(SourceFile& importer, llvm::StringRef headerName, cons
         return true;
     }
 
+    PhaseTimer timer("C header import", headerName);
     auto module = new Module(headerName);
+    CHeaderCache cache(headerName, options);
+
+    if (cache.load(*module)) {
+        addToStatistic(Statistic::CHeadersLoadedFromCache);
+        importer.addImportedModule(module);
+        Module::getAllImportedModulesMap()[module->getName()] = module;
+        return true;
+    }
 
     clang::CompilerInstance ci;
     ci.createDiagnostics();
@@ -362,6 +373,13 @@ bool delta::importCHeader(SourceFile& importer, llvm::StringRef headerName, cons
     clang::ParseAST(ci.getPreprocessor(), &ci.getASTConsumer(), ci.getASTContext());
     ci.getDiagnosticClient().EndSourceFile();
 
+    std::vector<std::string> includedFiles;
+    for (auto it = ci.getSourceManager().fileinfo_begin(), end = ci.getSourceManager().fileinfo_end(); it != end; ++it) {
+        includedFiles.push_back(it->first->getName().str());
+    }
+    cache.store(*module, includedFiles);
+    module->setHeaderFiles(std::move(includedFiles));
+
     importer.addImportedModule(module);
     Module::getAllImportedModulesMap()[module->getName()] = module;
     return true;
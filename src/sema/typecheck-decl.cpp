@@ -23,6 +23,13 @@ void Typechecker::typecheckType(Type type, AccessLevel userAccessLevel) {
 
             auto decls = findDecls(basicType->getQualifiedName());
             Decl* decl;
+            std::unique_lock<std::recursive_mutex> lock;
+
+            if (decls.empty()) {
+                lock = lockInstantiations();
+                // Another thread may have instantiated the type while we were waiting for the lock.
+                if (parallelState) decls = findDecls(basicType->getQualifiedName());
+            }
 
             if (decls.empty()) {
                 auto decls = findDecls(basicType->getName());
@@ -34,8 +41,7 @@ void Typechecker::typecheckType(Type type, AccessLevel userAccessLevel) {
                 ASSERT(decls.size() == 1);
                 decl = decls[0];
                 auto typeTemplate = llvm::cast<TypeTemplate>(decl)->instantiate(basicType->getGenericArgs());
-                getCurrentModule()->addToSymbolTable(*typeTemplate);
-                typecheckTypeDecl(*typeTemplate);
+                addInstantiation(*typeTemplate, false);
             } else {
                 ASSERT(decls.size() == 1);
                 decl = decls[0];
@@ -74,10 +80,12 @@ void Typechecker::typecheckType(Type type, AccessLevel userAccessLevel) {
             if (type.getPointee().isArrayWithRuntimeSize()) {
                 auto qualifiedTypeName = getQualifiedTypeName("ArrayRef", type.getPointee().getElementType());
                 if (findDecls(qualifiedTypeName).empty()) {
+                    auto lock = lockInstantiations();
+                    if (parallelState && !findDecls(qualifiedTypeName).empty()) break;
+
                     auto& arrayRef = llvm::cast<TypeTemplate>(findDecl("ArrayRef", SourceLocation()));
                     auto* instantiation = arrayRef.instantiate({ type.getPointee().getElementType() });
-                    getCurrentModule()->addToSymbolTable(*instantiation);
-                    declsToTypecheck.push_back(instantiation);
+                    addInstantiation(*instantiation, true);
                 }
             } else {
                 typecheckType(type.getPointee(), userAccessLevel);
@@ -141,9 +149,11 @@ void Typechecker::typecheckParams(llvm::MutableArrayRef<ParamDecl> params, Acces
     }
 }
 
-void Typechecker::typecheckFunctionDecl(FunctionDecl& decl) {
-    if (decl.isTypechecked()) return;
+void Typechecker::typecheckFunctionDecl(FunctionDecl& decl, bool isDeferredBody) {
+    if (decl.isTypechecked() && !isDeferredBody) return;
     if (decl.isExtern()) return; // TODO: Typecheck parameters and return type of extern functions.
+    // Deferred bodies are handed out to one thread each, other functions are typechecked by the first thread that reaches them.
+    if (parallelState && !isDeferredBody && !claimFunction(decl)) return;
 
     TypeDecl* receiverTypeDecl = decl.getTypeDecl();
 
@@ -162,6 +172,19 @@ void Typechecker::typecheckFunctionDecl(FunctionDecl& decl) {
         typecheckType(decl.getReturnType(), decl.getAccessLevel());
     }
 
+    if (hasPrecompiledBody(decl)) {
+        getCurrentModule()->getSymbolTable().popScope();
+        decl.setTypechecked(true);
+        return;
+    }
+
+    if (deferFunctionBodies && !decl.isLambda()) {
+        getCurrentModule()->getSymbolTable().popScope();
+        decl.setTypechecked(true);
+        deferredFunctionBodies.push_back({ &decl, currentModule, currentSourceFile, isPostProcessing });
+        return;
+    }
+
     if (!decl.isExtern()) {
         SAVE_STATE(functionReturnType);
         functionReturnType = decl.getReturnType();
@@ -214,11 +237,19 @@ void Typechecker::typecheckFunctionDecl(FunctionDecl& decl) {
     decl.setTypechecked(true);
 }
 
+bool Typechecker::hasPrecompiledBody(const FunctionDecl& decl) const {
+    if (!usePrecompiledStdlib || decl.getModule()->getName() != "std") return false;
+    if (!decl.getGenericArgs().empty()) return false;
+    return !decl.getTypeDecl() || decl.getTypeDecl()->getGenericArgs().empty();
+}
+
 void Typechecker::typecheckFunctionTemplate(FunctionTemplate& decl) {
     typecheckGenericParamDecls(decl.getGenericParams(), decl.getAccessLevel());
 }
 
 void Typechecker::typecheckTypeDecl(TypeDecl& decl) {
+    auto lock = lockInstantiations();
+
     for (Type interface : decl.getInterfaces()) {
         typecheckType(interface, decl.getAccessLevel());
         auto* interfaceDecl = interface.getDecl();
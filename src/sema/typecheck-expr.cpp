@@ -5,6 +5,7 @@
 #include <vector>
 #pragma warning(push, 0)
 #include <llvm/ADT/APSInt.h>
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/Optional.h>
 #include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/iterator_range.h>
@@ -46,7 +47,7 @@ static void checkNotMoved(const Decl& decl, const VarExpr& expr) {
 
 void Typechecker::checkHasAccess(const Decl& decl, SourceLocation location, AccessLevel userAccessLevel) {
     // FIXME: Compare SourceFile objects instead of file path strings.
-    if (decl.getAccessLevel() == AccessLevel::Private && strcmp(decl.getLocation().file, location.file) != 0) {
+    if (decl.getAccessLevel() == AccessLevel::Private && strcmp(decl.getLocation().getFile(), location.getFile()) != 0) {
         WARN(location, "'" << decl.getName() << "' is private");
     } else if (userAccessLevel != AccessLevel::None && decl.getAccessLevel() < userAccessLevel) {
         WARN(location, "using " << decl.getAccessLevel() << " type '" << decl.getName() << "' in " << userAccessLevel << " declaration");
@@ -820,10 +821,79 @@ static std::vector<Type> getGenericArgTypes(const llvm::StringMap<Type>& generic
     return types;
 }
 
+/// Returns a key identifying the overload resolution of the given call, or an empty string if the result can't be reused
+/// for other calls. The result can be reused only if it depends solely on the candidates and on the names, types and
+/// explicit generic arguments of the call, and not e.g. on the values of constant arguments, which may be implicitly
+/// converted to different types depending on their value.
+static std::string getOverloadResolutionKey(llvm::ArrayRef<Decl*> decls, const CallExpr& expr) {
+    if (decls.size() < 2) return "";
+
+    for (auto* decl : decls) {
+        if (!decl->isFunctionDecl() && !decl->isFunctionTemplate()) return "";
+    }
+
+    for (auto& arg : expr.getArgs()) {
+        auto* value = arg.getValue();
+        if (value->isConstant() || value->isNullLiteralExpr() || value->isUndefinedLiteralExpr() || value->isStringLiteralExpr() ||
+            value->isArrayLiteralExpr() || value->isTupleExpr() || value->isIfExpr() || value->isLambdaExpr()) {
+            return "";
+        }
+    }
+
+    std::string key;
+    llvm::raw_string_ostream stream(key);
+    auto writePointer = [&](const void* pointer) { stream.write(reinterpret_cast<const char*>(&pointer), sizeof(pointer)); };
+    auto writeType = [&](Type type) {
+        writePointer(type.getBase());
+        stream << (type.isMutable() ? 'm' : 'c');
+    };
+
+    stream << decls.size() << ':';
+    for (auto* decl : decls) {
+        writePointer(decl);
+    }
+
+    stream << expr.getArgs().size() << ':';
+    for (auto& arg : expr.getArgs()) {
+        writeType(arg.getValue()->getType());
+        stream << arg.getName() << '\0';
+    }
+
+    stream << expr.getGenericArgs().size() << ':';
+    for (auto genericArg : expr.getGenericArgs()) {
+        writeType(genericArg);
+    }
+
+    return stream.str();
+}
+
 Decl* Typechecker::resolveOverload(llvm::ArrayRef<Decl*> decls, CallExpr& expr, llvm::StringRef callee, bool returnNullOnError) {
+    auto resolutionKey = getOverloadResolutionKey(decls, expr);
+
+    if (!resolutionKey.empty()) {
+        auto it = resolvedOverloads.find(resolutionKey);
+        if (it != resolvedOverloads.end()) {
+            validateArgs(expr, *it->second);
+            return it->second;
+        }
+    }
+
     llvm::SmallVector<Decl*, 1> matches;
     std::vector<Decl*> initDecls;
     bool isInitCall = false;
+    // Matching function templates are instantiated only once they've been selected.
+    llvm::DenseMap<Decl*, llvm::StringMap<Type>> genericArgsForMatchingTemplates;
+
+    auto selectMatch = [&](Decl* match) {
+        if (auto* functionTemplate = llvm::dyn_cast<FunctionTemplate>(match)) {
+            match = functionTemplate->instantiate(genericArgsForMatchingTemplates.find(functionTemplate)->second);
+            declsToTypecheck.emplace_back(match);
+        }
+
+        validateArgs(expr, *match);
+        if (!resolutionKey.empty()) resolvedOverloads.try_emplace(resolutionKey, match);
+        return match;
+    };
 
     for (Decl* decl : decls) {
         switch (decl->getKind()) {
@@ -842,16 +912,16 @@ Decl* Typechecker::resolveOverload(llvm::ArrayRef<Decl*> decls, CallExpr& expr,
                 auto genericArgs = getGenericArgsForCall(genericParams, expr, params, decls.size() != 1);
                 if (genericArgs.empty()) continue; // Couldn't infer generic arguments.
 
-                auto* functionDecl = functionTemplate->instantiate(genericArgs);
-
                 if (decls.size() == 1 && !returnNullOnError) {
+                    auto* functionDecl = functionTemplate->instantiate(genericArgs);
                     validateArgs(expr, *functionDecl, callee, expr.getCallee().getLocation());
                     declsToTypecheck.emplace_back(functionDecl);
                     return functionDecl;
                 }
-                if (argumentsMatch(expr, functionDecl)) {
-                    declsToTypecheck.emplace_back(functionDecl); // TODO: Do this only after the final match has been selected.
-                    matches.push_back(functionDecl);
+                // Only the parameter types are needed for matching, so the body isn't instantiated for candidates that aren't selected.
+                if (argumentsMatch(expr, nullptr, instantiateParams(params, genericArgs))) {
+                    matches.push_back(functionTemplate);
+                    genericArgsForMatchingTemplates.try_emplace(functionTemplate, std::move(genericArgs));
                 }
                 break;
             }
@@ -914,12 +984,19 @@ Decl* Typechecker::resolveOverload(llvm::ArrayRef<Decl*> decls, CallExpr& expr,
                     if (genericArgs.empty()) continue; // Couldn't infer generic arguments.
 
                     TypeDecl* typeDecl = nullptr;
+                    auto qualifiedTypeName = getQualifiedTypeName(typeTemplate->getTypeDecl()->getName(), getGenericArgTypes(genericArgs));
+                    auto decls = findDecls(qualifiedTypeName);
+                    // Held while reading the methods too, since typechecking the instantiation may add methods to it.
+                    auto lock = lockInstantiations();
+
+                    // Another thread may have instantiated the type while we were waiting for the lock.
+                    if (decls.empty() && parallelState) {
+                        decls = findDecls(qualifiedTypeName);
+                    }
 
-                    auto decls = findDecls(getQualifiedTypeName(typeTemplate->getTypeDecl()->getName(), getGenericArgTypes(genericArgs)));
                     if (decls.empty()) {
                         typeDecl = typeTemplate->instantiate(genericArgs);
-                        getCurrentModule()->addToSymbolTable(*typeDecl);
-                        declsToTypecheck.push_back(typeDecl); // TODO: Can these be typechecked right away?
+                        addInstantiation(*typeDecl, true); // TODO: Can these be typechecked right away in serial mode?
                     } else {
                         typeDecl = llvm::cast<TypeDecl>(decls[0]);
                     }
@@ -971,8 +1048,7 @@ Decl* Typechecker::resolveOverload(llvm::ArrayRef<Decl*> decls, CallExpr& expr,
 
     switch (matches.size()) {
         case 1:
-            validateArgs(expr, *matches.front());
-            return matches.front();
+            return selectMatch(matches.front());
 
         case 0: {
             if (returnNullOnError) {
@@ -1010,14 +1086,12 @@ Decl* Typechecker::resolveOverload(llvm::ArrayRef<Decl*> decls, CallExpr& expr,
             });
 
             if (allMatchesAreFromC) {
-                validateArgs(expr, *matches.front());
-                return matches.front();
+                return selectMatch(matches.front());
             }
 
             for (auto* match : matches) {
                 if (match->getModule() && match->getModule()->getName() == "std") {
-                    validateArgs(expr, *match);
-                    return match;
+                    return selectMatch(match);
                 }
             }
 
@@ -1106,8 +1180,6 @@ Type Typechecker::typecheckCallExpr(CallExpr& expr) {
     } else {
         auto callee = expr.getFunctionName();
         auto decls = findCalleeCandidates(expr, callee);
-        // TODO: Prevent duplicates and remove this call:
-        decls.erase(std::unique(decls.begin(), decls.end()), decls.end());
         decl = resolveOverload(decls, expr, callee);
 
         if (auto* initDecl = llvm::dyn_cast<InitDecl>(decl)) {
@@ -1,4 +1,8 @@
 #include "typecheck.h"
+#pragma warning(push, 0)
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+#pragma warning(pop)
 #include "../ast/module.h"
 
 using namespace delta;
@@ -161,6 +165,186 @@ void Typechecker::typecheckCompoundStmt(CompoundStmt& compoundStmt) {
     getCurrentModule()->getSymbolTable().popScope();
 }
 
+static bool isStdType(const TypeDecl* typeDecl, llvm::StringRef name) {
+    return typeDecl && typeDecl->getName() == name && typeDecl->getModule() && typeDecl->getModule()->getName() == "std";
+}
+
+static bool isList(Type type) {
+    return isStdType(type.removePointer().getDecl(), "List");
+}
+
+/// Returns true if a value of the given type contains a List by value, so that assigning to it may modify the List.
+static bool containsList(Type type) {
+    switch (type.getKind()) {
+        case TypeKind::BasicType: {
+            auto* typeDecl = type.getDecl();
+            if (!typeDecl) return false;
+            if (isStdType(typeDecl, "List")) return true;
+            return llvm::any_of(typeDecl->getFields(), [](const FieldDecl& field) { return containsList(field.getType()); });
+        }
+        case TypeKind::ArrayType:
+            return containsList(type.getElementType());
+        case TypeKind::TupleType:
+            return llvm::any_of(type.getTupleElements(), [](const TupleElement& element) { return containsList(element.type); });
+        case TypeKind::OptionalType:
+            return containsList(type.getWrappedType());
+        case TypeKind::FunctionType:
+        case TypeKind::PointerType:
+            return false;
+    }
+    llvm_unreachable("all cases handled");
+}
+
+/// Returns the local List variable or parameter 'list' if the range is of the form '<constant >= 0>..list.size()'.
+static const Decl* getListIndexedByRange(const Expr& range) {
+    auto* binaryExpr = llvm::dyn_cast<BinaryExpr>(&range);
+    if (!binaryExpr || binaryExpr->getOperator() != Token::DotDot) return nullptr;
+
+    auto& start = binaryExpr->getLHS();
+    if (!start.isConstant() || !start.getType().isInteger() || start.getConstantIntegerValue().isNegative()) return nullptr;
+
+    auto* sizeCall = llvm::dyn_cast<CallExpr>(&binaryExpr->getRHS());
+    if (!sizeCall || !sizeCall->isMethodCall() || sizeCall->getFunctionName() != "size" || !sizeCall->getArgs().empty()) return nullptr;
+
+    auto* listExpr = llvm::dyn_cast<VarExpr>(sizeCall->getReceiver());
+    if (!listExpr || !isList(listExpr->getType())) return nullptr;
+
+    auto* listDecl = listExpr->getDecl();
+    if (auto* varDecl = llvm::dyn_cast<VarDecl>(listDecl)) {
+        if (!varDecl->getParent() || !varDecl->getParent()->isFunctionDecl()) return nullptr;
+    } else if (!llvm::isa<ParamDecl>(listDecl)) {
+        return nullptr;
+    }
+
+    return listDecl;
+}
+
+static bool isReferenceTo(const Expr& expr, const Decl* decl) {
+    auto* varExpr = llvm::dyn_cast<VarExpr>(&expr);
+    return varExpr && varExpr->getDecl() == decl;
+}
+
+namespace {
+/// Checks that a for-loop body can't modify the list whose indices the loop iterates over, nor the loop variable,
+/// and collects the subscripts that index the list with the loop variable.
+struct InBoundsSubscriptFinder {
+    const Decl* list;
+    const Decl* loopVariable;
+    /// The references to 'list' that are the receiver of a call that doesn't modify it.
+    llvm::SmallPtrSet<const Expr*, 16> allowedListReferences;
+    llvm::SmallVector<const SubscriptExpr*, 8> subscripts;
+
+    bool visit(const Expr& expr);
+    bool visit(const Stmt& stmt);
+    bool visit(llvm::ArrayRef<Stmt*> stmts) {
+        return llvm::all_of(stmts, [&](const Stmt* stmt) { return visit(*stmt); });
+    }
+};
+} // namespace
+
+bool InBoundsSubscriptFinder::visit(const Expr& expr) {
+    if (expr.isLambdaExpr()) return false;
+
+    if (isReferenceTo(expr, list)) {
+        return allowedListReferences.count(&expr) != 0;
+    }
+
+    if (expr.isAssignment() || expr.isIncrementOrDecrementExpr()) {
+        auto& target = *llvm::cast<CallExpr>(expr).getArgs()[0].getValue();
+        if (isReferenceTo(target, loopVariable) || isList(target.getType()) || containsList(target.getType())) return false;
+
+        // Fields of the list, e.g. 'list.size', aren't private.
+        if (auto* memberExpr = llvm::dyn_cast<MemberExpr>(&target)) {
+            if (isList(memberExpr->getBaseExpr()->getType())) return false;
+        }
+    }
+
+    if (auto* unaryExpr = llvm::dyn_cast<UnaryExpr>(&expr)) {
+        if (unaryExpr->getOperator() == Token::And && isReferenceTo(unaryExpr->getOperand(), loopVariable)) return false;
+    }
+
+    if (auto* callExpr = llvm::dyn_cast<CallExpr>(&expr)) {
+        if (auto* calleeDecl = callExpr->getCalleeDecl()) {
+            auto* subscriptExpr = llvm::dyn_cast<SubscriptExpr>(callExpr);
+            auto* receiver = callExpr->getReceiver();
+
+            if (receiver && isReferenceTo(*receiver, list) && (subscriptExpr || callExpr->getFunctionName() == "size")) {
+                allowedListReferences.insert(receiver);
+                if (subscriptExpr && isReferenceTo(*subscriptExpr->getIndexExpr(), loopVariable)) {
+                    subscripts.push_back(subscriptExpr);
+                }
+            } else {
+                // Any other function could modify the list through a pointer to it, except for the methods of ranges and
+                // their iterators, which allows nested loops.
+                auto* typeDecl = llvm::isa<MethodDecl>(calleeDecl) ? llvm::cast<MethodDecl>(calleeDecl)->getTypeDecl() : nullptr;
+                auto rangeTypes = { "Range", "ClosedRange", "RangeIterator", "ClosedRangeIterator" };
+                if (llvm::none_of(rangeTypes, [&](const char* name) { return isStdType(typeDecl, name); })) return false;
+            }
+        }
+    }
+
+    return llvm::all_of(expr.getSubExprs(), [&](const Expr* subExpr) { return visit(*subExpr); });
+}
+
+bool InBoundsSubscriptFinder::visit(const Stmt& stmt) {
+    switch (stmt.getKind()) {
+        case StmtKind::ReturnStmt: {
+            auto* returnValue = llvm::cast<ReturnStmt>(stmt).getReturnValue();
+            return !returnValue || visit(*returnValue);
+        }
+        case StmtKind::VarStmt: {
+            auto* initializer = llvm::cast<VarStmt>(stmt).getDecl().getInitializer();
+            return !initializer || visit(*initializer);
+        }
+        case StmtKind::ExprStmt:
+            return visit(llvm::cast<ExprStmt>(stmt).getExpr());
+        case StmtKind::DeferStmt:
+            return visit(llvm::cast<DeferStmt>(stmt).getExpr());
+        case StmtKind::IfStmt: {
+            auto& ifStmt = llvm::cast<IfStmt>(stmt);
+            return visit(ifStmt.getCondition()) && visit(ifStmt.getThenBody()) && visit(ifStmt.getElseBody());
+        }
+        case StmtKind::SwitchStmt: {
+            auto& switchStmt = llvm::cast<SwitchStmt>(stmt);
+            if (!visit(switchStmt.getCondition()) || !visit(switchStmt.getDefaultStmts())) return false;
+            return llvm::all_of(switchStmt.getCases(), [&](const SwitchCase& switchCase) {
+                return (!switchCase.getValue() || visit(*switchCase.getValue())) && visit(switchCase.getStmts());
+            });
+        }
+        case StmtKind::WhileStmt: {
+            auto& whileStmt = llvm::cast<WhileStmt>(stmt);
+            auto* increment = whileStmt.getIncrement();
+            return visit(whileStmt.getCondition()) && visit(whileStmt.getBody()) && (!increment || visit(*increment));
+        }
+        case StmtKind::ForStmt:
+            llvm_unreachable("ForStmt should be lowered into a WhileStmt");
+        case StmtKind::BreakStmt:
+        case StmtKind::ContinueStmt:
+            return true;
+        case StmtKind::CompoundStmt:
+            return visit(llvm::cast<CompoundStmt>(stmt).getBody());
+    }
+    llvm_unreachable("all cases handled");
+}
+
+/// Marks the List subscripts in a loop of the form 'for (var i in 0..list.size()) { ... list[i] ... }' as being in
+/// bounds, so that their bounds checks are omitted, if the loop body can't modify 'list' or 'i'. The loop has already
+/// been lowered into the form '{ var __iterator = (0..list.size()).iterator(); while (...) { var i = ...; ... } }'.
+static void markInBoundsSubscripts(const ForStmt& forStmt, const CompoundStmt& loweredForStmt) {
+    auto* list = getListIndexedByRange(forStmt.getRangeExpr());
+    if (!list) return;
+
+    auto& whileStmt = llvm::cast<WhileStmt>(*loweredForStmt.getBody().back());
+    auto& loopVariable = llvm::cast<VarStmt>(*whileStmt.getBody().front()).getDecl();
+    InBoundsSubscriptFinder finder{ list, &loopVariable, {}, {} };
+
+    if (finder.visit(whileStmt.getBody().drop_front())) {
+        for (auto* subscript : finder.subscripts) {
+            const_cast<SubscriptExpr*>(subscript)->setIndexInBounds();
+        }
+    }
+}
+
 void Typechecker::typecheckStmt(Stmt*& stmt) {
     switch (stmt->getKind()) {
         case StmtKind::ReturnStmt:
@@ -185,10 +369,12 @@ void Typechecker::typecheckStmt(Stmt*& stmt) {
             typecheckWhileStmt(llvm::cast<WhileStmt>(*stmt));
             break;
         case StmtKind::ForStmt: {
-            typecheckExpr(llvm::cast<ForStmt>(*stmt).getRangeExpr());
+            auto& forStmt = llvm::cast<ForStmt>(*stmt);
+            typecheckExpr(forStmt.getRangeExpr());
             auto nestLevel = llvm::count_if(currentControlStmts, [](auto* stmt) { return stmt->isWhileStmt(); });
-            stmt = llvm::cast<ForStmt>(*stmt).lower(nestLevel);
+            stmt = forStmt.lower(nestLevel);
             typecheckStmt(stmt);
+            markInBoundsSubscripts(forStmt, llvm::cast<CompoundStmt>(*stmt));
             break;
         }
         case StmtKind::BreakStmt:
@@ -1,12 +1,16 @@
 #include "typecheck.h"
+#include <atomic>
 #pragma warning(push, 0)
+#include <llvm/ADT/ScopeExit.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Path.h>
+#include <llvm/Support/ThreadPool.h>
 #pragma warning(pop)
 #include "../ast/module.h"
 #include "../driver/driver.h"
 #include "../package-manager/manifest.h"
 #include "../parser/parse.h"
+#include "../support/statistics.h"
 
 using namespace delta;
 
@@ -233,7 +237,9 @@ llvm::Optional<bool> Typechecker::maySetToNullBeforeEvaluating(const Expr& var,
 
 TypeDecl* Typechecker::getTypeDecl(const BasicType& type) {
     if (auto* typeDecl = type.getDecl()) {
-        return typeDecl;
+        if (!isInstantiationInProgress()) return typeDecl;
+        auto lock = lockInstantiations();
+        return type.getDecl();
     }
 
     auto decls = findDecls(type.getQualifiedName());
@@ -243,15 +249,60 @@ TypeDecl* Typechecker::getTypeDecl(const BasicType& type) {
         return llvm::dyn_cast_or_null<TypeDecl>(decls[0]);
     }
 
+    auto lock = lockInstantiations();
+
+    // Another thread may have instantiated the type while we were waiting for the lock.
+    if (parallelState) {
+        decls = findDecls(type.getQualifiedName());
+        if (!decls.empty()) return llvm::dyn_cast_or_null<TypeDecl>(decls[0]);
+    }
+
     decls = findDecls(type.getName());
     if (decls.empty()) return nullptr;
     ASSERT(decls.size() == 1);
     auto instantiation = llvm::cast<TypeTemplate>(decls[0])->instantiate(type.getGenericArgs());
-    getCurrentModule()->addToSymbolTable(*instantiation);
-    declsToTypecheck.push_back(instantiation);
+    addInstantiation(*instantiation, true);
     return instantiation;
 }
 
+std::unique_lock<std::recursive_mutex> Typechecker::lockInstantiations() const {
+    if (!parallelState) return {};
+    return std::unique_lock<std::recursive_mutex>(parallelState->instantiationMutex);
+}
+
+/// Returns true if another thread may be in the middle of adding an instantiation, in which case declarations found
+/// without holding the instantiation lock may be incomplete. Must be checked after the lookup, not before it.
+bool Typechecker::isInstantiationInProgress() const {
+    return parallelState && parallelState->instantiationsInProgress.load() != 0;
+}
+
+/// Adds a type template instantiation to the current module. Must be called while holding the instantiation lock.
+/// In parallel mode, the instantiation is typechecked right away, before the lock is released. Other threads can
+/// find it as soon as it's in the symbol table, but until it's complete, isInstantiationInProgress() makes them
+/// repeat their lookups under the lock, which waits for the instantiation to be completed.
+void Typechecker::addInstantiation(TypeDecl& instantiation, bool deferTypechecking) {
+    if (!parallelState) {
+        getCurrentModule()->addToSymbolTable(instantiation);
+
+        if (deferTypechecking) {
+            declsToTypecheck.push_back(&instantiation);
+        } else {
+            typecheckTypeDecl(instantiation);
+        }
+        return;
+    }
+
+    ++parallelState->instantiationsInProgress;
+    auto decrement = llvm::make_scope_exit([&] { --parallelState->instantiationsInProgress; });
+    getCurrentModule()->addToSymbolTable(instantiation);
+    typecheckTypeDecl(instantiation);
+}
+
+bool Typechecker::claimFunction(const FunctionDecl& decl) const {
+    std::lock_guard<std::mutex> lock(parallelState->claimMutex);
+    return parallelState->claimedFunctions.insert(&decl).second;
+}
+
 static std::error_code parseSourcesInDirectoryRecursively(const llvm::Twine& directoryPath, Module& module, const CompileOptions& options) {
     std::error_code error;
     llvm::sys::fs::recursive_directory_iterator it(directoryPath, error), end;
@@ -301,6 +352,11 @@ done:
 
     if (importer) importer->addImportedModule(module);
     Module::getAllImportedModulesMap()[module->getName()] = module;
+
+    if (moduleName == "std" && precompiledStdlibLoader) {
+        usePrecompiledStdlib = precompiledStdlibLoader(*module);
+    }
+
     typecheckModule(*module, nullptr);
     return *module;
 }
@@ -347,6 +403,11 @@ static void checkUnusedDecls(const Module& module) {
 }
 
 void Typechecker::typecheckModule(Module& module, const PackageManifest* manifest) {
+    // Modules imported by this one are typechecked recursively, so their function bodies are deferred along with this module's.
+    bool typecheckBodiesInParallel = threadCount > 1 && !deferFunctionBodies;
+    if (typecheckBodiesInParallel) deferFunctionBodies = true;
+    PhaseTimer timer("Typechecking", module.getName());
+
     auto stdModule = importDeltaModule(nullptr, nullptr, "std");
     if (!stdModule) {
         ABORT("couldn't import the standard library: " << stdModule.getError().message());
@@ -379,11 +440,80 @@ void Typechecker::typecheckModule(Module& module, const PackageManifest* manifes
     }
 
     if (module.getName() != "std" && isWarningEnabled("unused")) {
-        checkUnusedDecls(module);
+        // Declarations are marked as referenced while typechecking function bodies.
+        if (deferFunctionBodies) {
+            modulesToCheckForUnusedDecls.push_back(&module);
+        } else {
+            checkUnusedDecls(module);
+        }
     }
 
     currentModule = nullptr;
     currentSourceFile = nullptr;
+
+    if (typecheckBodiesInParallel) {
+        deferFunctionBodies = false;
+        typecheckDeferredFunctionBodies();
+
+        for (auto* moduleToCheck : modulesToCheckForUnusedDecls) {
+            checkUnusedDecls(*moduleToCheck);
+        }
+        modulesToCheckForUnusedDecls.clear();
+    }
+}
+
+void Typechecker::typecheckDeferredFunctionBodies() {
+    PhaseTimer timer("Typechecking", "function bodies");
+    auto functionBodies = std::move(deferredFunctionBodies);
+    ParallelTypecheckingState state;
+    std::atomic<size_t> nextIndex(0);
+    std::atomic<bool> failed(false);
+    std::mutex errorMutex;
+    llvm::Optional<CompileError> error;
+    size_t errorIndex = 0;
+
+    auto typecheckFunctionBodies = [&] {
+        Typechecker typechecker(options);
+        typechecker.parallelState = &state;
+        typechecker.usePrecompiledStdlib = usePrecompiledStdlib;
+
+        while (!failed) {
+            size_t index = nextIndex++;
+            if (index >= functionBodies.size()) break;
+            auto& functionBody = functionBodies[index];
+
+            try {
+                typechecker.currentModule = functionBody.module;
+                typechecker.currentSourceFile = functionBody.sourceFile;
+                typechecker.isPostProcessing = functionBody.isPostProcessing;
+                typechecker.typecheckFunctionDecl(*functionBody.decl, true);
+                typechecker.postProcess();
+            } catch (const CompileError& compileError) {
+                // Report the error of the earliest function body, which is the one the serial typechecker would report.
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error || index < errorIndex) {
+                    error = compileError;
+                    errorIndex = index;
+                }
+                failed = true;
+            }
+        }
+    };
+
+    // The local scopes of the serial typechecker are kept per symbol table rather than per thread, so there must be none.
+    for (auto* module : Module::getAllImportedModules()) {
+        ASSERT(&module->getSymbolTable().getCurrentScope() == &module->getSymbolTable().getGlobalScope());
+    }
+    CompilationContext::setMultithreaded(true);
+    auto resetMultithreaded = llvm::make_scope_exit([] { CompilationContext::setMultithreaded(false); });
+
+    llvm::ThreadPool threadPool(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threadPool.async(typecheckFunctionBodies);
+    }
+    threadPool.wait();
+
+    if (error) throw *error;
 }
 
 bool Typechecker::isWarningEnabled(llvm::StringRef warning) const {
@@ -394,7 +524,7 @@ static llvm::SmallVector<Decl*, 1> findDeclsInModules(llvm::StringRef name, llvm
     llvm::SmallVector<Decl*, 1> decls;
 
     for (auto& module : modules) {
-        llvm::ArrayRef<Decl*> matches = module->getSymbolTable().find(name);
+        auto matches = module->getSymbolTable().find(name);
         decls.append(matches.begin(), matches.end());
     }
 
@@ -423,10 +553,9 @@ Decl& Typechecker::findDecl(llvm::StringRef name, SourceLocation location) const
 
     if (currentFunction) {
         if (auto* typeDecl = currentFunction->getTypeDecl()) {
-            for (auto& field : typeDecl->getFields()) {
-                if (field.getName() == name) {
-                    return field;
-                }
+            auto lock = lockInstantiations();
+            if (auto* field = typeDecl->findField(name)) {
+                return *field;
             }
         }
     }
@@ -448,45 +577,74 @@ Decl& Typechecker::findDecl(llvm::StringRef name, SourceLocation location) const
     ERROR(location, "unknown identifier '" << name << "'");
 }
 
-std::vector<Decl*> Typechecker::findDecls(llvm::StringRef name, TypeDecl* receiverTypeDecl, bool inAllImportedModules) const {
-    std::vector<Decl*> decls;
+llvm::ArrayRef<Module*> Typechecker::getLookupModules(bool inAllImportedModules) const {
+    auto& cache = lookupModulesCache;
+    inAllImportedModules = inAllImportedModules || !currentSourceFile;
+    // Modules are only ever added to these lists, so a change in their total size means the visible modules may have changed.
+    auto importedModuleCount = Module::getAllImportedModulesMap().size() + (currentSourceFile ? currentSourceFile->getImportedModules().size() : 0);
 
-    if (!receiverTypeDecl && currentFunction) {
-        receiverTypeDecl = currentFunction->getTypeDecl();
+    if (cache.module == currentModule && cache.sourceFile == currentSourceFile && cache.inAllImportedModules == inAllImportedModules &&
+        cache.importedModuleCount == importedModuleCount) {
+        return cache.modules;
     }
 
-    if (receiverTypeDecl) {
-        for (auto& decl : receiverTypeDecl->getMemberDecls()) {
-            if (auto* functionDecl = llvm::dyn_cast<FunctionDecl>(decl)) {
-                if (functionDecl->getName() == name) {
-                    decls.emplace_back(decl);
-                }
-            } else if (auto* functionTemplate = llvm::dyn_cast<FunctionTemplate>(decl)) {
-                if (functionTemplate->getQualifiedName() == name) {
-                    decls.emplace_back(decl);
-                }
-            }
-        }
+    cache.module = currentModule;
+    cache.sourceFile = currentSourceFile;
+    cache.inAllImportedModules = inAllImportedModules;
+    cache.importedModuleCount = importedModuleCount;
+    cache.modules.clear();
 
-        for (auto& field : receiverTypeDecl->getFields()) {
-            // TODO: Only one comparison should be needed.
-            if (field.getName() == name || field.getQualifiedName() == name) {
-                decls.emplace_back(&field);
-            }
+    auto addModule = [&](Module* module) {
+        if (!llvm::is_contained(cache.modules, module)) {
+            cache.modules.push_back(module);
         }
-    }
+    };
 
     if (currentModule->getName() != "std") {
-        append(decls, findDeclsInModules(name, currentModule));
+        addModule(currentModule);
     }
 
-    append(decls, findDeclsInModules(name, currentModule->getStdlibModules()));
+    for (auto* module : currentModule->getStdlibModules()) {
+        addModule(module);
+    }
 
-    if (currentSourceFile && !inAllImportedModules) {
-        append(decls, findDeclsInModules(name, currentSourceFile->getImportedModules()));
+    if (inAllImportedModules) {
+        for (auto* module : currentModule->getAllImportedModules()) {
+            addModule(module);
+        }
     } else {
-        append(decls, findDeclsInModules(name, currentModule->getAllImportedModules()));
+        for (auto* module : currentSourceFile->getImportedModules()) {
+            addModule(module);
+        }
+    }
+
+    return cache.modules;
+}
+
+std::vector<Decl*> Typechecker::findDecls(llvm::StringRef name, TypeDecl* receiverTypeDecl, bool inAllImportedModules) const {
+    auto decls = findDeclsUnlocked(name, receiverTypeDecl, inAllImportedModules);
+    if (!isInstantiationInProgress()) return decls;
+
+    auto lock = lockInstantiations();
+    return findDeclsUnlocked(name, receiverTypeDecl, inAllImportedModules);
+}
+
+std::vector<Decl*> Typechecker::findDeclsUnlocked(llvm::StringRef name, TypeDecl* receiverTypeDecl, bool inAllImportedModules) const {
+    std::vector<Decl*> decls;
+
+    if (!receiverTypeDecl && currentFunction) {
+        receiverTypeDecl = currentFunction->getTypeDecl();
+    }
+
+    if (receiverTypeDecl) {
+        auto lock = lockInstantiations();
+        append(decls, receiverTypeDecl->findMethods(name));
+
+        if (auto* field = receiverTypeDecl->findField(name)) {
+            decls.emplace_back(field);
+        }
     }
 
+    append(decls, findDeclsInModules(name, getLookupModules(inAllImportedModules)));
     return decls;
 }
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
+#include <mutex>
 #include <string>
 #include <vector>
 #pragma warning(push, 0)
+#include <llvm/ADT/DenseSet.h>
 #include <llvm/ADT/StringMap.h>
 #include <llvm/Support/ErrorOr.h>
 #pragma warning(pop)
@@ -28,11 +31,31 @@ struct SourceLocation;
 struct Type;
 struct CompileOptions;
 
+/// State shared by the typecheckers that typecheck function bodies in parallel, see Typechecker::setTypecheckThreadCount().
+struct ParallelTypecheckingState {
+    /// Held while instantiating templates and typechecking the resulting type declarations, and while looking up
+    /// members, because typechecking a type declaration may add methods to it.
+    std::recursive_mutex instantiationMutex;
+    /// The number of instantiations that have been added to a symbol table but not typechecked yet. While it's nonzero,
+    /// the result of a lookup made without holding instantiationMutex may be incomplete, so it's repeated under the lock.
+    std::atomic<int> instantiationsInProgress{ 0 };
+    std::mutex claimMutex;
+    /// Functions whose typechecking has been started by one of the threads.
+    llvm::DenseSet<const FunctionDecl*> claimedFunctions;
+};
+
 class Typechecker {
 public:
     Typechecker(const CompileOptions& options)
     : currentModule(nullptr), currentSourceFile(nullptr), currentFunction(nullptr), isPostProcessing(false), options(options) {}
     void typecheckModule(Module& module, const PackageManifest* manifest);
+    /// Sets a callback that's invoked once the standard library has been parsed. If it returns true,
+    /// precompiled code is used for the standard library, and the bodies of its non-generic functions
+    /// aren't typechecked.
+    void setPrecompiledStdlibLoader(std::function<bool(const Module& stdModule)> loader) { precompiledStdlibLoader = std::move(loader); }
+    /// Sets the number of threads used to typecheck function bodies. If greater than one, declarations and function
+    /// signatures are typechecked first, after which the function bodies are typechecked in parallel.
+    void setTypecheckThreadCount(unsigned count) { threadCount = count; }
 
 private:
     Module* getCurrentModule() const { return NOTNULL(currentModule); }
@@ -41,8 +64,9 @@ private:
     void typecheckFieldDecl(FieldDecl& decl);
     void typecheckTopLevelDecl(Decl& decl, const PackageManifest* manifest);
     void typecheckParams(llvm::MutableArrayRef<ParamDecl> params, AccessLevel userAccessLevel);
-    void typecheckFunctionDecl(FunctionDecl& decl);
+    void typecheckFunctionDecl(FunctionDecl& decl, bool isDeferredBody = false);
     void typecheckFunctionTemplate(FunctionTemplate& decl);
+    bool hasPrecompiledBody(const FunctionDecl& decl) const;
     void typecheckMemberDecl(Decl& decl);
 
     void typecheckStmt(Stmt*& stmt);
@@ -87,6 +111,9 @@ private:
                                                 llvm::ArrayRef<ParamDecl> params, bool returnOnError);
     Decl& findDecl(llvm::StringRef name, SourceLocation location) const;
     std::vector<Decl*> findDecls(llvm::StringRef name, TypeDecl* receiverTypeDecl = nullptr, bool inAllImportedModules = false) const;
+    std::vector<Decl*> findDeclsUnlocked(llvm::StringRef name, TypeDecl* receiverTypeDecl, bool inAllImportedModules) const;
+    /// Returns the modules whose top-level declarations are visible to name lookup, each listed once.
+    llvm::ArrayRef<Module*> getLookupModules(bool inAllImportedModules) const;
     std::vector<Decl*> findCalleeCandidates(const CallExpr& expr, llvm::StringRef callee);
     Decl* resolveOverload(llvm::ArrayRef<Decl*> decls, CallExpr& expr, llvm::StringRef callee, bool returnNullOnError = false);
     std::vector<Type> inferGenericArgs(llvm::ArrayRef<GenericParamDecl> genericParams, CallExpr& call, llvm::ArrayRef<ParamDecl> params, bool returnOnError);
@@ -101,6 +128,11 @@ private:
     void checkLambdaCapture(const VariableDecl& variableDecl, const VarExpr& varExpr) const;
     llvm::ErrorOr<const Module&> importDeltaModule(SourceFile* importer, const PackageManifest* manifest, llvm::StringRef moduleName);
     void postProcess();
+    void typecheckDeferredFunctionBodies();
+    std::unique_lock<std::recursive_mutex> lockInstantiations() const;
+    bool isInstantiationInProgress() const;
+    void addInstantiation(TypeDecl& instantiation, bool deferTypechecking);
+    bool claimFunction(const FunctionDecl& decl) const;
 
     /// Returns true if the given expression (of optional type) is guaranteed to be non-null, e.g.
     /// if it was previously checked against null, and the type-checker can prove that it wasn't set
@@ -128,7 +160,35 @@ private:
     Type functionReturnType;
     bool isPostProcessing;
     std::vector<Decl*> declsToTypecheck;
+    std::function<bool(const Module&)> precompiledStdlibLoader;
+    bool usePrecompiledStdlib = false;
     const CompileOptions& options;
+
+    unsigned threadCount = 1;
+    /// Set while typechecking declarations before the function bodies are typechecked in parallel.
+    bool deferFunctionBodies = false;
+    struct DeferredFunctionBody {
+        FunctionDecl* decl;
+        Module* module;
+        SourceFile* sourceFile;
+        bool isPostProcessing;
+    };
+    std::vector<DeferredFunctionBody> deferredFunctionBodies;
+    std::vector<Module*> modulesToCheckForUnusedDecls;
+    /// Non-null in the typecheckers that typecheck function bodies in parallel.
+    ParallelTypecheckingState* parallelState = nullptr;
+
+    /// Results of overload resolution that can be reused for other calls, see getOverloadResolutionKey().
+    llvm::StringMap<Decl*> resolvedOverloads;
+    /// The result of the last getLookupModules() call, which is reused until the set of visible modules changes.
+    struct LookupModules {
+        const Module* module = nullptr;
+        const SourceFile* sourceFile = nullptr;
+        bool inAllImportedModules = false;
+        size_t importedModuleCount = 0;
+        std::vector<Module*> modules;
+    };
+    mutable LookupModules lookupModulesCache;
 };
 
 void validateGenericArgCount(size_t genericParamCount, llvm::ArrayRef<Type> genericArgs, llvm::StringRef name, SourceLocation location);
@@ -0,0 +1,164 @@
+#include "statistics.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#pragma warning(push, 0)
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/Support/Timer.h>
+#pragma warning(pop)
+#include "utility.h"
+
+using namespace delta;
+
+static const char* const statisticDescriptions[] = {
+    "tokens lexed", "AST nodes allocated", "types interned", "templates instantiated", "functions emitted", "LLVM instructions generated",
+    "C headers loaded from cache",
+};
+
+static std::atomic<uint64_t> statistics[llvm::array_lengthof(statisticDescriptions)];
+
+void delta::addToStatistic(Statistic statistic, uint64_t amount) {
+    statistics[static_cast<size_t>(statistic)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+void delta::printStatistics(llvm::raw_ostream& stream) {
+    stream << "===" << std::string(73, '-') << "===\n";
+    stream << "                          ... Statistics Collected ...\n";
+    stream << "===" << std::string(73, '-') << "===\n\n";
+
+    for (size_t i = 0; i < llvm::array_lengthof(statisticDescriptions); ++i) {
+        stream << llvm::format_decimal(statistics[i].load(), 12) << ' ' << statisticDescriptions[i] << '\n';
+    }
+
+    stream << '\n';
+    stream.flush();
+}
+
+namespace {
+struct TraceEvent {
+    const char* phase;
+    std::string detail;
+    uint64_t startTime;
+    uint64_t duration;
+    uint64_t threadID;
+};
+
+struct PhaseTimers {
+    std::mutex mutex;
+    bool isTimeReportEnabled = false;
+    bool isTimeTraceEnabled = false;
+    // Declared before the timers so that it's destroyed after them.
+    llvm::TimerGroup timerGroup{ "delta", "Compiler phase timing report" };
+    llvm::StringMap<std::unique_ptr<llvm::Timer>> timers;
+    std::chrono::steady_clock::time_point traceStartTime;
+    std::vector<TraceEvent> traceEvents;
+};
+} // namespace
+
+static PhaseTimers& getPhaseTimers() {
+    static PhaseTimers phaseTimers;
+    return phaseTimers;
+}
+
+/// The innermost phase that's running on the current thread.
+static thread_local PhaseTimer* currentPhaseTimer = nullptr;
+
+void delta::enableTimeReport() {
+    getPhaseTimers().isTimeReportEnabled = true;
+}
+
+void delta::printTimeReport(llvm::raw_ostream& stream) {
+    auto& phaseTimers = getPhaseTimers();
+    std::lock_guard<std::mutex> lock(phaseTimers.mutex);
+    phaseTimers.timerGroup.print(stream);
+    // Prevent the report from being printed again when the timers are destroyed.
+    phaseTimers.timerGroup.clear();
+}
+
+void delta::enableTimeTrace() {
+    auto& phaseTimers = getPhaseTimers();
+    phaseTimers.isTimeTraceEnabled = true;
+    phaseTimers.traceStartTime = std::chrono::steady_clock::now();
+}
+
+void delta::writeTimeTrace(llvm::StringRef filePath) {
+    auto& phaseTimers = getPhaseTimers();
+    std::lock_guard<std::mutex> lock(phaseTimers.mutex);
+    llvm::json::Array events;
+
+    for (auto& event : phaseTimers.traceEvents) {
+        llvm::json::Object args;
+        if (!event.detail.empty()) args["detail"] = event.detail;
+
+        events.push_back(llvm::json::Object{
+            { "name", event.phase },
+            { "ph", "X" },
+            { "ts", int64_t(event.startTime) },
+            { "dur", int64_t(event.duration) },
+            { "pid", 1 },
+            { "tid", int64_t(event.threadID) },
+            { "args", std::move(args) },
+        });
+    }
+
+    std::error_code error;
+    llvm::raw_fd_ostream file(filePath, error, llvm::sys::fs::F_Text);
+    if (error) ABORT("couldn't write '" << filePath << "': " << error.message());
+    file << llvm::json::Object{ { "traceEvents", std::move(events) } } << '\n';
+}
+
+static uint64_t getTraceTime(const PhaseTimers& phaseTimers) {
+    auto elapsed = std::chrono::steady_clock::now() - phaseTimers.traceStartTime;
+    return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+PhaseTimer::PhaseTimer(const char* phase, llvm::StringRef detail) : timer(nullptr), parent(nullptr), phase(phase), startTime(0) {
+    auto& phaseTimers = getPhaseTimers();
+    isEnabled = phaseTimers.isTimeReportEnabled || phaseTimers.isTimeTraceEnabled;
+    if (!isEnabled) return;
+
+    this->detail = detail;
+    parent = currentPhaseTimer;
+    currentPhaseTimer = this;
+
+    if (phaseTimers.isTimeReportEnabled) {
+        std::string description = detail.empty() ? std::string(phase) : (llvm::Twine(phase) + " (" + detail + ")").str();
+        std::lock_guard<std::mutex> lock(phaseTimers.mutex);
+        auto& timerEntry = phaseTimers.timers[description];
+        if (!timerEntry) timerEntry = std::make_unique<llvm::Timer>(description, description, phaseTimers.timerGroup);
+        timer = timerEntry.get();
+    }
+
+    if (timer) {
+        if (parent && parent->timer) parent->timer->stopTimer();
+        timer->startTimer();
+    }
+
+    if (phaseTimers.isTimeTraceEnabled) {
+        startTime = getTraceTime(phaseTimers);
+    }
+}
+
+PhaseTimer::~PhaseTimer() {
+    if (!isEnabled) return;
+    auto& phaseTimers = getPhaseTimers();
+
+    if (timer) {
+        timer->stopTimer();
+        if (parent && parent->timer) parent->timer->startTimer();
+    }
+
+    currentPhaseTimer = parent;
+
+    if (phaseTimers.isTimeTraceEnabled) {
+        auto duration = getTraceTime(phaseTimers) - startTime;
+        std::lock_guard<std::mutex> lock(phaseTimers.mutex);
+        phaseTimers.traceEvents.push_back({ phase, std::move(detail), startTime, duration, llvm::get_threadid() });
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#pragma warning(push, 0)
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/raw_ostream.h>
+#pragma warning(pop)
+
+namespace llvm {
+class Timer;
+}
+
+namespace delta {
+
+enum class Statistic {
+    TokensLexed,
+    NodesAllocated,
+    TypesInterned,
+    TemplatesInstantiated,
+    FunctionsEmitted,
+    InstructionsGenerated,
+    CHeadersLoadedFromCache,
+};
+
+/// Increments a counter printed by -stats. Thread-safe.
+void addToStatistic(Statistic statistic, uint64_t amount = 1);
+void printStatistics(llvm::raw_ostream& stream);
+
+void enableTimeReport();
+void printTimeReport(llvm::raw_ostream& stream);
+void enableTimeTrace();
+/// Writes the phases recorded since enableTimeTrace() as a trace viewable in chrome://tracing.
+void writeTimeTrace(llvm::StringRef filePath);
+
+/// Measures the time spent in a compiler phase for -time-report and -trace-json, from construction
+/// until destruction. The detail (e.g. the module name) separates instances of the same phase in the
+/// report. Time spent in a nested phase is reported only for the nested phase, not the enclosing one.
+class PhaseTimer {
+public:
+    PhaseTimer(const char* phase, llvm::StringRef detail = "");
+    ~PhaseTimer();
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    llvm::Timer* timer;
+    PhaseTimer* parent;
+    const char* phase;
+    std::string detail;
+    uint64_t startTime;
+    bool isEnabled;
+};
+
+} // namespace delta
@@ -1,7 +1,7 @@
 #include "utility.h"
 #include <algorithm>
 #include <cctype>
-#include <fstream>
+#include <mutex>
 #pragma warning(push, 0)
 #include <llvm/Support/CommandLine.h>
 #include <llvm/Support/ErrorOr.h>
@@ -11,18 +11,6 @@
 
 using namespace delta;
 
-std::string delta::readLineFromFile(SourceLocation location) {
-    std::ifstream file(location.file);
-
-    while (--location.line) {
-        file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    }
-
-    std::string lineContent;
-    std::getline(file, lineContent);
-    return lineContent;
-}
-
 void delta::renameFile(llvm::Twine sourcePath, llvm::Twine targetPath) {
     auto permissions = llvm::sys::fs::getPermissions(sourcePath);
     if (auto error = permissions.getError()) {
@@ -40,27 +28,29 @@ void delta::renameFile(llvm::Twine sourcePath, llvm::Twine targetPath) {
 }
 
 void delta::printDiagnostic(SourceLocation location, llvm::StringRef type, llvm::raw_ostream::Colors color, llvm::StringRef message) {
+    // Warnings may be reported from multiple threads when typechecking in parallel.
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+
     if (llvm::outs().has_colors()) {
         llvm::outs().changeColor(llvm::raw_ostream::SAVEDCOLOR, true);
     }
 
-    if (location.file && *location.file) {
-        llvm::outs() << location.file;
-        if (location.isValid()) {
-            llvm::outs() << ':' << location.line << ':' << location.column;
-        }
-        llvm::outs() << ": ";
+    DecodedSourceLocation decoded = {};
+
+    if (location.isValid()) {
+        decoded = SourceManager::decode(location);
+        llvm::outs() << decoded.file << ':' << decoded.line << ':' << decoded.column << ": ";
     }
 
     printColored(type, color);
     printColored(": ", color);
     printColored(message, llvm::raw_ostream::SAVEDCOLOR);
 
-    if (location.file && *location.file && location.isValid()) {
-        auto line = readLineFromFile(location);
-        llvm::outs() << '\n' << line << '\n';
+    if (location.isValid()) {
+        llvm::outs() << '\n' << decoded.lineContent << '\n';
 
-        for (char ch : line.substr(0, location.column - 1)) {
+        for (char ch : decoded.lineContent.substr(0, decoded.column - 1)) {
             llvm::outs() << (ch != '\t' ? ' ' : '\t');
         }
         printColored('^', llvm::raw_ostream::GREEN);
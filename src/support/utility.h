@@ -78,7 +78,6 @@ private:
     std::string message;
 };
 
-std::string readLineFromFile(SourceLocation location);
 void renameFile(llvm::Twine sourcePath, llvm::Twine targetPath);
 void printDiagnostic(SourceLocation location, llvm::StringRef type, llvm::raw_ostream::Colors color, llvm::StringRef message);
 
@@ -0,0 +1,46 @@
+#!/usr/bin/env python
+
+# Measures the throughput of the lexer on a synthetic ~50 MB source file built from the standard library.
+# Usage: lexer.py [path/to/delta]
+
+import glob
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+delta_path = os.path.abspath(sys.argv[1]) if len(sys.argv) > 1 else "delta"
+stdlib_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "std")
+target_size = 50 * 1024 * 1024
+runs = 5
+
+sources = []
+for source in sorted(glob.glob(os.path.join(stdlib_path, "**", "*.delta"), recursive=True)):
+    with open(source, "rb") as file:
+        sources.append(file.read() + b"\n")
+
+corpus = b"".join(sources)
+output_directory = tempfile.mkdtemp()
+input_path = os.path.join(output_directory, "lexer-benchmark.delta")
+
+with open(input_path, "wb") as file:
+    size = 0
+    while size < target_size:
+        file.write(corpus)
+        size += len(corpus)
+
+print("lexer ({:.1f} MB)".format(size / (1024.0 * 1024.0)))
+
+fastest = None
+for _ in range(runs):
+    start = time.time()
+    if subprocess.call([delta_path, input_path, "-lex"]) != 0:
+        print("FAIL: lexing " + input_path)
+        sys.exit(1)
+    elapsed = time.time() - start
+    fastest = elapsed if fastest is None else min(fastest, elapsed)
+
+shutil.rmtree(output_directory)
+print("  {:24} {:8.3f} s {:10.1f} MB/s".format("best of " + str(runs), fastest, size / (1024.0 * 1024.0) / fastest))
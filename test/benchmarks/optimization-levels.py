@@ -0,0 +1,63 @@
+#!/usr/bin/env python
+
+# Compares the runtime and binary size of the examples across the optimization levels.
+# Usage: optimization-levels.py [path/to/delta]
+
+import glob
+import os
+import platform
+import subprocess
+import sys
+import tempfile
+import time
+
+delta_path = os.path.abspath(sys.argv[1]) if len(sys.argv) > 1 else "delta"
+examples_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "examples")
+optimization_levels = ["-O0", "-O1", "-O2", "-O3"]
+extension = ".exe" if platform.system() == "Windows" else ".out"
+output_directory = tempfile.mkdtemp()
+
+
+def build(args, cwd):
+    exit_status = subprocess.call([delta_path] + args, cwd=cwd)
+    if exit_status != 0:
+        print("FAIL: delta " + " ".join(args))
+        sys.exit(1)
+
+
+def benchmark_brainfuck():
+    print("examples/brainfuck.delta (runtime on inputs/mandel.b, executable size)")
+
+    for level in optimization_levels:
+        executable = os.path.join(output_directory, "brainfuck" + level + extension)
+        build(["brainfuck.delta", level, "-o", executable], examples_path)
+
+        with open(os.devnull, "w") as devnull:
+            start = time.time()
+            subprocess.call([executable], cwd=examples_path, stdout=devnull)
+            elapsed = time.time() - start
+
+        print("  {:4} {:8.3f} s {:10} bytes".format(level, elapsed, os.path.getsize(executable)))
+
+
+def benchmark_asteroids():
+    asteroids_path = os.path.join(examples_path, "asteroids")
+
+    try:
+        sdl_cflags = subprocess.check_output(["pkg-config", "sdl2", "--cflags"]).decode().split()
+    except (OSError, subprocess.CalledProcessError):
+        print("examples/asteroids: skipped, SDL2 not found")
+        return
+
+    print("examples/asteroids (object file size)")
+    sources = [os.path.basename(path) for path in glob.glob(os.path.join(asteroids_path, "*.delta"))]
+    object_file = os.path.join(asteroids_path, "output.o")
+
+    for level in optimization_levels:
+        build(["-c"] + sources + [level] + sdl_cflags, asteroids_path)
+        print("  {:4} {:10} bytes".format(level, os.path.getsize(object_file)))
+        os.remove(object_file)
+
+
+benchmark_brainfuck()
+benchmark_asteroids()
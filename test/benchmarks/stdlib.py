@@ -0,0 +1,37 @@
+#!/usr/bin/env python
+
+# Measures the runtime of the standard library benchmarks in test/stdlib/benchmarks.
+# Usage: stdlib.py [path/to/delta]
+
+import glob
+import os
+import platform
+import subprocess
+import sys
+import tempfile
+import time
+
+delta_path = os.path.abspath(sys.argv[1]) if len(sys.argv) > 1 else "delta"
+benchmarks_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "stdlib", "benchmarks")
+extension = ".exe" if platform.system() == "Windows" else ".out"
+output_directory = tempfile.mkdtemp()
+
+print("test/stdlib/benchmarks (runtime at -O2)")
+
+for source in sorted(glob.glob(os.path.join(benchmarks_path, "*.delta"))):
+    name = os.path.splitext(os.path.basename(source))[0]
+    executable = os.path.join(output_directory, name + extension)
+
+    if subprocess.call([delta_path, source, "-O2", "-o", executable]) != 0:
+        print("FAIL: building " + source)
+        sys.exit(1)
+
+    start = time.time()
+    exit_status = subprocess.call([executable], cwd=benchmarks_path)
+    elapsed = time.time() - start
+
+    if exit_status != 0:
+        print("FAIL: " + name + " exited with status " + str(exit_status))
+        sys.exit(1)
+
+    print("  {:24} {:8.3f} s".format(name, elapsed))
@@ -0,0 +1,43 @@
+#!/usr/bin/env python
+
+# Prints a Delta program with the given number of functions that instantiate the same generic types and call their
+# methods, returning 0 from main.
+
+import sys
+
+count = int(sys.argv[1])
+
+print("""struct Box<T>: Copyable {
+    T value;
+
+    init(T value) {
+        this.value = value;
+    }
+
+    T get() {
+        return value;
+    }
+}""")
+
+for i in range(count):
+    print("""
+int f{0}() {{
+    var list = List<int>();
+    list.push({0});
+    var set = Set<int>();
+    set.insert({0});
+    var map = Map<int, bool>();
+    map.insert({0}, true);
+    var box = Box({0});
+    var boxes = List<Box<int>>();
+    boxes.push(box);
+    return list[0] + set.size() + map.size() + boxes[0].get() - 2 * {0} - 2;
+}}""".format(i))
+
+print("")
+print("int main() {")
+print("    var sum = 0;")
+for i in range(count):
+    print("    sum += f{0}();".format(i))
+print("    return sum;")
+print("}")
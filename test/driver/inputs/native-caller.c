@@ -0,0 +1,6 @@
+// Calls a function defined in Delta code by its mangled name.
+int _EN4main8callbackE(void);
+
+int callDelta(void) {
+    return _EN4main8callbackE();
+}
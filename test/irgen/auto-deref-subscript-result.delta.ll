@@ -1,12 +1,12 @@
 
 %"S<int>" = type { i32 }
 
-define i32* @_EN4main1SI3intEixE1i3int(%"S<int>"* %this, i32 %i) {
+define weak_odr i32* @_EN4main1SI3intEixE1i3int(%"S<int>"* %this, i32 %i) {
   %t = getelementptr inbounds %"S<int>", %"S<int>"* %this, i32 0, i32 0
   ret i32* %t
 }
 
-define void @_EN4main1SI3intE4initE1t3int(%"S<int>"* %this, i32 %t) {
+define weak_odr void @_EN4main1SI3intE4initE1t3int(%"S<int>"* %this, i32 %t) {
   %t1 = getelementptr inbounds %"S<int>", %"S<int>"* %this, i32 0, i32 0
   store i32 %t, i32* %t1
   ret void
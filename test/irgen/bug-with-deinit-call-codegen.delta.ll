@@ -17,10 +17,10 @@ define void @_EN4main1X4initE({}* %this) {
   ret void
 }
 
-define i32 @_EN4main1YI4boolE1fE({}* %this) {
+define weak_odr i32 @_EN4main1YI4boolE1fE({}* %this) {
   ret i32 1
 }
 
-define void @_EN4main1YI4boolE4initE({}* %this) {
+define weak_odr void @_EN4main1YI4boolE4initE({}* %this) {
   ret void
 }
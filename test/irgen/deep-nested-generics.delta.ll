@@ -23,31 +23,31 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1AI1RE4initE(%"A<R>"* %this) {
+define weak_odr void @_EN4main1AI1RE4initE(%"A<R>"* %this) {
   ret void
 }
 
-define %R @_EN4main1AI1REixE1i3int(%"A<R>"* %this, i32 %i) {
+define weak_odr %R @_EN4main1AI1REixE1i3int(%"A<R>"* %this, i32 %i) {
   %t = getelementptr inbounds %"A<R>", %"A<R>"* %this, i32 0, i32 0
   %t.load = load %R, %R* %t
   ret %R %t.load
 }
 
-define void @_EN4main1AI1AI1REE4initE(%"A<A<R>>"* %this) {
+define weak_odr void @_EN4main1AI1AI1REE4initE(%"A<A<R>>"* %this) {
   ret void
 }
 
-define %"A<R>" @_EN4main1AI1AI1REEixE1i3int(%"A<A<R>>"* %this, i32 %i) {
+define weak_odr %"A<R>" @_EN4main1AI1AI1REEixE1i3int(%"A<A<R>>"* %this, i32 %i) {
   %t = getelementptr inbounds %"A<A<R>>", %"A<A<R>>"* %this, i32 0, i32 0
   %t.load = load %"A<R>", %"A<R>"* %t
   ret %"A<R>" %t.load
 }
 
-define void @_EN4main1SI1RE4initE(%"S<R>"* %this) {
+define weak_odr void @_EN4main1SI1RE4initE(%"S<R>"* %this) {
   ret void
 }
 
-define void @_EN4main1SI1RE1sE(%"S<R>"* %this) {
+define weak_odr void @_EN4main1SI1RE1sE(%"S<R>"* %this) {
   %t = alloca %"A<R>"
   %tt = alloca %R
   %a = getelementptr inbounds %"S<R>", %"S<R>"* %this, i32 0, i32 0
@@ -3,11 +3,8 @@
 %"ArrayRef<char>" = type { i8*, i32 }
 
 @0 = private unnamed_addr constant [3 x i8] c"\5Cn\00", align 1
+@__str0 = private unnamed_addr constant %StringRef { %"ArrayRef<char>" { i8* getelementptr inbounds ([3 x i8], [3 x i8]* @0, i32 0, i32 0), i32 2 } }
 
 define i32 @main() {
-  %__str0 = alloca %StringRef
-  call void @_EN3std9StringRef4initE7pointerP4char6length3int(%StringRef* %__str0, i8* getelementptr inbounds ([3 x i8], [3 x i8]* @0, i32 0, i32 0), i32 2)
   ret i32 0
 }
-
-declare void @_EN3std9StringRef4initE7pointerP4char6length3int(%StringRef*, i8*, i32)
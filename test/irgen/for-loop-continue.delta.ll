@@ -4,13 +4,12 @@
 %"ArrayRef<char>" = type { i8*, i32 }
 
 @0 = private unnamed_addr constant [4 x i8] c"abc\00", align 1
+@__str0 = private unnamed_addr constant %StringRef { %"ArrayRef<char>" { i8* getelementptr inbounds ([4 x i8], [4 x i8]* @0, i32 0, i32 0), i32 3 } }
 
 define i32 @main() {
   %__iterator = alloca %StringIterator
-  %__str0 = alloca %StringRef
   %ch = alloca i8
-  call void @_EN3std9StringRef4initE7pointerP4char6length3int(%StringRef* %__str0, i8* getelementptr inbounds ([4 x i8], [4 x i8]* @0, i32 0, i32 0), i32 3)
-  %1 = call %StringIterator @_EN3std9StringRef8iteratorE(%StringRef* %__str0)
+  %1 = call %StringIterator @_EN3std9StringRef8iteratorE(%StringRef* @__str0)
   store %StringIterator %1, %StringIterator* %__iterator
   br label %loop.condition
 
@@ -44,8 +43,6 @@ if.end:                                           ; preds = %if.else
 
 declare %StringIterator @_EN3std9StringRef8iteratorE(%StringRef*)
 
-declare void @_EN3std9StringRef4initE7pointerP4char6length3int(%StringRef*, i8*, i32)
-
 declare i1 @_EN3std14StringIterator8hasValueE(%StringIterator*)
 
 declare i8 @_EN3std14StringIterator5valueE(%StringIterator*)
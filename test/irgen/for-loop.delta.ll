@@ -34,7 +34,7 @@ loop.end:                                         ; preds = %loop.condition
   ret i32 0
 }
 
-define void @_EN3std11ClosedRangeI3intE4initE5start3int3end3int(%"ClosedRange<int>"* %this, i32 %start, i32 %end) {
+define weak_odr void @_EN3std11ClosedRangeI3intE4initE5start3int3end3int(%"ClosedRange<int>"* %this, i32 %start, i32 %end) {
   %start1 = getelementptr inbounds %"ClosedRange<int>", %"ClosedRange<int>"* %this, i32 0, i32 0
   store i32 %start, i32* %start1
   %end2 = getelementptr inbounds %"ClosedRange<int>", %"ClosedRange<int>"* %this, i32 0, i32 1
@@ -42,12 +42,12 @@ define void @_EN3std11ClosedRangeI3intE4initE5start3int3end3int(%"ClosedRange<in
   ret void
 }
 
-define void @_EN3std11ClosedRangeI3intE4initE3end3int(%"ClosedRange<int>"* %this, i32 %end) {
+define weak_odr void @_EN3std11ClosedRangeI3intE4initE3end3int(%"ClosedRange<int>"* %this, i32 %end) {
   call void @_EN3std11ClosedRangeI3intE4initE5start3int3end3int(%"ClosedRange<int>"* %this, i32 0, i32 %end)
   ret void
 }
 
-define i32 @_EN3std11ClosedRangeI3intE4sizeE(%"ClosedRange<int>"* %this) {
+define weak_odr i32 @_EN3std11ClosedRangeI3intE4sizeE(%"ClosedRange<int>"* %this) {
   %end = getelementptr inbounds %"ClosedRange<int>", %"ClosedRange<int>"* %this, i32 0, i32 1
   %end.load = load i32, i32* %end
   %start = getelementptr inbounds %"ClosedRange<int>", %"ClosedRange<int>"* %this, i32 0, i32 0
@@ -57,24 +57,24 @@ define i32 @_EN3std11ClosedRangeI3intE4sizeE(%"ClosedRange<int>"* %this) {
   ret i32 %2
 }
 
-define i32 @_EN3std11ClosedRangeI3intE6lengthE(%"ClosedRange<int>"* %this) {
+define weak_odr i32 @_EN3std11ClosedRangeI3intE6lengthE(%"ClosedRange<int>"* %this) {
   %1 = call i32 @_EN3std11ClosedRangeI3intE4sizeE(%"ClosedRange<int>"* %this)
   ret i32 %1
 }
 
-define i32 @_EN3std11ClosedRangeI3intE5startE(%"ClosedRange<int>"* %this) {
+define weak_odr i32 @_EN3std11ClosedRangeI3intE5startE(%"ClosedRange<int>"* %this) {
   %start = getelementptr inbounds %"ClosedRange<int>", %"ClosedRange<int>"* %this, i32 0, i32 0
   %start.load = load i32, i32* %start
   ret i32 %start.load
 }
 
-define i32 @_EN3std11ClosedRangeI3intE3endE(%"ClosedRange<int>"* %this) {
+define weak_odr i32 @_EN3std11ClosedRangeI3intE3endE(%"ClosedRange<int>"* %this) {
   %end = getelementptr inbounds %"ClosedRange<int>", %"ClosedRange<int>"* %this, i32 0, i32 1
   %end.load = load i32, i32* %end
   ret i32 %end.load
 }
 
-define %"ClosedRangeIterator<int>" @_EN3std11ClosedRangeI3intE8iteratorE(%"ClosedRange<int>"* %this) {
+define weak_odr %"ClosedRangeIterator<int>" @_EN3std11ClosedRangeI3intE8iteratorE(%"ClosedRange<int>"* %this) {
   %1 = alloca %"ClosedRangeIterator<int>"
   %this.load = load %"ClosedRange<int>", %"ClosedRange<int>"* %this
   call void @_EN3std19ClosedRangeIteratorI3intE4initE5range11ClosedRangeI3intE(%"ClosedRangeIterator<int>"* %1, %"ClosedRange<int>" %this.load)
@@ -82,7 +82,7 @@ define %"ClosedRangeIterator<int>" @_EN3std11ClosedRangeI3intE8iteratorE(%"Close
   ret %"ClosedRangeIterator<int>" %.load
 }
 
-define void @_EN3std19ClosedRangeIteratorI3intE4initE5range11ClosedRangeI3intE(%"ClosedRangeIterator<int>"* %this, %"ClosedRange<int>" %range) {
+define weak_odr void @_EN3std19ClosedRangeIteratorI3intE4initE5range11ClosedRangeI3intE(%"ClosedRangeIterator<int>"* %this, %"ClosedRange<int>" %range) {
   %1 = alloca %"ClosedRange<int>"
   %2 = alloca %"ClosedRange<int>"
   %current = getelementptr inbounds %"ClosedRangeIterator<int>", %"ClosedRangeIterator<int>"* %this, i32 0, i32 0
@@ -98,7 +98,7 @@ define void @_EN3std19ClosedRangeIteratorI3intE4initE5range11ClosedRangeI3intE(%
 
 declare void @_EN3std19ClosedRangeIteratorI3intE4initE5range11ClosedRangeI3intE.1(%"ClosedRangeIterator<int>"*, %"ClosedRange<int>")
 
-define i1 @_EN3std19ClosedRangeIteratorI3intE8hasValueE(%"ClosedRangeIterator<int>"* %this) {
+define weak_odr i1 @_EN3std19ClosedRangeIteratorI3intE8hasValueE(%"ClosedRangeIterator<int>"* %this) {
   %current = getelementptr inbounds %"ClosedRangeIterator<int>", %"ClosedRangeIterator<int>"* %this, i32 0, i32 0
   %current.load = load i32, i32* %current
   %end = getelementptr inbounds %"ClosedRangeIterator<int>", %"ClosedRangeIterator<int>"* %this, i32 0, i32 1
@@ -107,13 +107,13 @@ define i1 @_EN3std19ClosedRangeIteratorI3intE8hasValueE(%"ClosedRangeIterator<in
   ret i1 %1
 }
 
-define i32 @_EN3std19ClosedRangeIteratorI3intE5valueE(%"ClosedRangeIterator<int>"* %this) {
+define weak_odr i32 @_EN3std19ClosedRangeIteratorI3intE5valueE(%"ClosedRangeIterator<int>"* %this) {
   %current = getelementptr inbounds %"ClosedRangeIterator<int>", %"ClosedRangeIterator<int>"* %this, i32 0, i32 0
   %current.load = load i32, i32* %current
   ret i32 %current.load
 }
 
-define void @_EN3std19ClosedRangeIteratorI3intE9incrementE(%"ClosedRangeIterator<int>"* %this) {
+define weak_odr void @_EN3std19ClosedRangeIteratorI3intE9incrementE(%"ClosedRangeIterator<int>"* %this) {
   %current = getelementptr inbounds %"ClosedRangeIterator<int>", %"ClosedRangeIterator<int>"* %this, i32 0, i32 0
   %current.load = load i32, i32* %current
   %1 = add i32 %current.load, 1
@@ -2,7 +2,7 @@
 %"S<int>" = type { i32 }
 %"S<bool>" = type { i1 }
 
-define void @_EN4main1SI3intE4initE1f3int(%"S<int>"* %this, i32 %f) {
+define weak_odr void @_EN4main1SI3intE4initE1f3int(%"S<int>"* %this, i32 %f) {
   %f1 = getelementptr inbounds %"S<int>", %"S<int>"* %this, i32 0, i32 0
   store i32 %f, i32* %f1
   ret void
@@ -17,7 +17,7 @@ define i1 @_EN4maineqI3intEE1a1SI3intE1b1SI3intE(%"S<int>" %a, %"S<int>" %b) {
   ret i1 true
 }
 
-define void @_EN4main1SI4boolE4initE1f4bool(%"S<bool>"* %this, i1 %f) {
+define weak_odr void @_EN4main1SI4boolE4initE1f4bool(%"S<bool>"* %this, i1 %f) {
   %f1 = getelementptr inbounds %"S<bool>", %"S<bool>"* %this, i32 0, i32 0
   store i1 %f, i1* %f1
   ret void
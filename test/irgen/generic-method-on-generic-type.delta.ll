@@ -11,10 +11,10 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1XI3intE4initE({}* %this) {
+define weak_odr void @_EN4main1XI3intE4initE({}* %this) {
   ret void
 }
 
-define void @_EN4main1XI3intE1fI4boolEE1uF4bool_3int({}* %this, i32 (i1)* %u) {
+define weak_odr void @_EN4main1XI3intE1fI4boolEE1uF4bool_3int({}* %this, i32 (i1)* %u) {
   ret void
 }
@@ -9,12 +9,12 @@ define i32 @main({} %x) {
   ret i32 0
 }
 
-define {} @_EN4main1XI3intE1fI4boolEE1u4bool({}* %this, i1 %u) {
+define weak_odr {} @_EN4main1XI3intE1fI4boolEE1u4bool({}* %this, i1 %u) {
   %x = alloca {}
   %x.load = load {}, {}* %x
   ret {} %x.load
 }
 
-define void @_EN4main1XI4boolE1gE({}* %this) {
+define weak_odr void @_EN4main1XI4boolE1gE({}* %this) {
   ret void
 }
@@ -19,12 +19,12 @@ define void @_EN4main1X4initE({}* %this) {
   ret void
 }
 
-define i32 @_EN4main1X1fI3intEE1tF_3int({}* %this, i32 ()* %t) {
+define weak_odr i32 @_EN4main1X1fI3intEE1tF_3int({}* %this, i32 ()* %t) {
   %1 = call i32 %t()
   ret i32 %1
 }
 
-define i1 @_EN4main1X1fI4boolEE1tF_4bool({}* %this, i1 ()* %t) {
+define weak_odr i1 @_EN4main1X1fI4boolEE1tF_4bool({}* %this, i1 ()* %t) {
   %1 = call i1 %t()
   ret i1 %1
 }
@@ -13,7 +13,7 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1AI1CE4initE({}* %this) {
+define weak_odr void @_EN4main1AI1CE4initE({}* %this) {
   %t = alloca %C
   call void @_EN4main1C4initE(%C* %t)
   ret void
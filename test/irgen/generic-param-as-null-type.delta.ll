@@ -10,7 +10,7 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1SI3intE4initE(%"S<int>"* %this) {
+define weak_odr void @_EN4main1SI3intE4initE(%"S<int>"* %this) {
   %p = getelementptr inbounds %"S<int>", %"S<int>"* %this, i32 0, i32 0
   store i32* null, i32** %p
   ret void
@@ -18,7 +18,7 @@ define void @_EN4main1SI3intE4initE(%"S<int>"* %this) {
 
 declare void @_EN4main1SI3intE4initE.1(%"S<int>"*)
 
-define void @_EN4main1SI4boolE4initE(%"S<bool>"* %this) {
+define weak_odr void @_EN4main1SI4boolE4initE(%"S<bool>"* %this) {
   %p = getelementptr inbounds %"S<bool>", %"S<bool>"* %this, i32 0, i32 0
   store i1* null, i1** %p
   ret void
@@ -6,17 +6,17 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1SI3intE4initE({}* %this) {
+define weak_odr void @_EN4main1SI3intE4initE({}* %this) {
   ret void
 }
 
-define void @_EN4main1SI3intE1fE({}* %this) {
+define weak_odr void @_EN4main1SI3intE1fE({}* %this) {
   %t = alloca i32
   call void @_EN4main1SI3intE1gE({}* %this)
   ret void
 }
 
-define void @_EN4main1SI3intE1gE({}* %this) {
+define weak_odr void @_EN4main1SI3intE1gE({}* %this) {
   %t2 = alloca i32
   ret void
 }
@@ -9,18 +9,18 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1CI3intE6deinitE({}* %this) {
+define weak_odr void @_EN4main1CI3intE6deinitE({}* %this) {
   ret void
 }
 
-define void @_EN4main1CI3intE4initE({}* %this) {
+define weak_odr void @_EN4main1CI3intE4initE({}* %this) {
   ret void
 }
 
-define void @_EN4main1CI4boolE6deinitE({}* %this) {
+define weak_odr void @_EN4main1CI4boolE6deinitE({}* %this) {
   ret void
 }
 
-define void @_EN4main1CI4boolE4initE({}* %this) {
+define weak_odr void @_EN4main1CI4boolE4initE({}* %this) {
   ret void
 }
@@ -27,13 +27,13 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN3std8ArrayRefI3intE4initE(%"ArrayRef<int>"* %this) {
+define weak_odr void @_EN3std8ArrayRefI3intE4initE(%"ArrayRef<int>"* %this) {
   %size = getelementptr inbounds %"ArrayRef<int>", %"ArrayRef<int>"* %this, i32 0, i32 1
   store i32 0, i32* %size
   ret void
 }
 
-define void @_EN3std4ListI3intE4initE(%"List<int>"* %this) {
+define weak_odr void @_EN3std4ListI3intE4initE(%"List<int>"* %this) {
   %size = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 1
   store i32 0, i32* %size
   %capacity = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 2
@@ -41,13 +41,13 @@ define void @_EN3std4ListI3intE4initE(%"List<int>"* %this) {
   ret void
 }
 
-define void @_EN3std4ListI3intE4initE8capacity3int(%"List<int>"* %this, i32 %capacity) {
+define weak_odr void @_EN3std4ListI3intE4initE8capacity3int(%"List<int>"* %this, i32 %capacity) {
   call void @_EN3std4ListI3intE4initE(%"List<int>"* %this)
   call void @_EN3std4ListI3intE7reserveE15minimumCapacity3int(%"List<int>"* %this, i32 %capacity)
   ret void
 }
 
-define void @_EN3std4ListI3intE7reserveE15minimumCapacity3int(%"List<int>"* %this, i32 %minimumCapacity) {
+define weak_odr void @_EN3std4ListI3intE7reserveE15minimumCapacity3int(%"List<int>"* %this, i32 %minimumCapacity) {
   %newBuffer = alloca i32*
   %__iterator = alloca %"RangeIterator<int>"
   %1 = alloca %"Range<int>"
@@ -125,7 +125,7 @@ if.end5:                                          ; preds = %if.else4, %if.then3
   br label %if.end
 }
 
-define void @_EN3std4ListI3intE4initE8elementsPAR_3int(%"List<int>"* %this, %"ArrayRef<int>" %elements) {
+define weak_odr void @_EN3std4ListI3intE4initE8elementsPAR_3int(%"List<int>"* %this, %"ArrayRef<int>" %elements) {
   %__iterator = alloca %"RangeIterator<int>"
   %1 = alloca %"Range<int>"
   %index = alloca i32
@@ -167,7 +167,7 @@ declare i1 @_EN3std13RangeIteratorI3intE8hasValueE(%"RangeIterator<int>"*)
 
 declare i32 @_EN3std13RangeIteratorI3intE5valueE(%"RangeIterator<int>"*)
 
-define void @_EN3std4ListI3intE4pushE10newElement3int(%"List<int>"* %this, i32 %newElement) {
+define weak_odr void @_EN3std4ListI3intE4pushE10newElement3int(%"List<int>"* %this, i32 %newElement) {
   %size = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 1
   %size.load = load i32, i32* %size
   %capacity = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 2
@@ -198,7 +198,7 @@ if.end:                                           ; preds = %if.else, %if.then
 
 declare void @_EN3std13RangeIteratorI3intE9incrementE(%"RangeIterator<int>"*)
 
-define void @_EN3std4ListI3intE6deinitE(%"List<int>"* %this) {
+define weak_odr void @_EN3std4ListI3intE6deinitE(%"List<int>"* %this) {
   %capacity = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 2
   %capacity.load = load i32, i32* %capacity
   %1 = icmp ne i32 %capacity.load, 0
@@ -217,32 +217,32 @@ if.end:                                           ; preds = %if.else, %if.then
   ret void
 }
 
-define void @_EN3std10deallocateIAU_3intEE10allocationPAU_3int(i32* %allocation) {
+define weak_odr void @_EN3std10deallocateIAU_3intEE10allocationPAU_3int(i32* %allocation) {
   %1 = bitcast i32* %allocation to i8*
   call void @free(i8* %1)
   ret void
 }
 
-define i32 @_EN3std4ListI3intE4sizeE(%"List<int>"* %this) {
+define weak_odr i32 @_EN3std4ListI3intE4sizeE(%"List<int>"* %this) {
   %size = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 1
   %size.load = load i32, i32* %size
   ret i32 %size.load
 }
 
-define i1 @_EN3std4ListI3intE5emptyE(%"List<int>"* %this) {
+define weak_odr i1 @_EN3std4ListI3intE5emptyE(%"List<int>"* %this) {
   %size = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 1
   %size.load = load i32, i32* %size
   %1 = icmp eq i32 %size.load, 0
   ret i1 %1
 }
 
-define i32 @_EN3std4ListI3intE8capacityE(%"List<int>"* %this) {
+define weak_odr i32 @_EN3std4ListI3intE8capacityE(%"List<int>"* %this) {
   %capacity = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 2
   %capacity.load = load i32, i32* %capacity
   ret i32 %capacity.load
 }
 
-define i32* @_EN3std4ListI3intEixE5index3int(%"List<int>"* %this, i32 %index) {
+define weak_odr i32* @_EN3std4ListI3intEixE5index3int(%"List<int>"* %this, i32 %index) {
   %size = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 1
   %size.load = load i32, i32* %size
   %1 = icmp sge i32 %index, %size.load
@@ -262,14 +262,21 @@ if.end:                                           ; preds = %if.else, %if.then
   ret i32* %2
 }
 
-define void @_EN3std4ListI3intE16indexOutOfBoundsE5index3int(%"List<int>"* %this, i32 %index) {
+define weak_odr void @_EN3std4ListI3intE16indexOutOfBoundsE5index3int(%"List<int>"* %this, i32 %index) {
   %1 = call i32 @_EN3std4ListI3intE4sizeE(%"List<int>"* %this)
   %2 = call i32 (i8*, ...) @printf(i8* getelementptr inbounds ([44 x i8], [44 x i8]* @2, i32 0, i32 0), i32 %index, i32 %1)
   call void @_EN3std10fatalErrorE()
   ret void
 }
 
-define i32* @_EN3std4ListI3intE5firstE(%"List<int>"* %this) {
+define weak_odr i32* @_EN3std4ListI3intE18uncheckedSubscriptE5index3int(%"List<int>"* %this, i32 %index) {
+  %buffer = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 0
+  %buffer.load = load i32*, i32** %buffer
+  %1 = getelementptr i32, i32* %buffer.load, i32 %index
+  ret i32* %1
+}
+
+define weak_odr i32* @_EN3std4ListI3intE5firstE(%"List<int>"* %this) {
   %size = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 1
   %size.load = load i32, i32* %size
   %1 = icmp eq i32 %size.load, 0
@@ -289,13 +296,13 @@ if.end:                                           ; preds = %if.else, %if.then
   ret i32* %2
 }
 
-define void @_EN3std4ListI3intE14emptyListFirstE(%"List<int>"* %this) {
+define weak_odr void @_EN3std4ListI3intE14emptyListFirstE(%"List<int>"* %this) {
   %1 = call i32 (i8*, ...) @printf(i8* getelementptr inbounds ([30 x i8], [30 x i8]* @3, i32 0, i32 0))
   call void @_EN3std10fatalErrorE()
   ret void
 }
 
-define i32* @_EN3std4ListI3intE4lastE(%"List<int>"* %this) {
+define weak_odr i32* @_EN3std4ListI3intE4lastE(%"List<int>"* %this) {
   %size = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 1
   %size.load = load i32, i32* %size
   %1 = icmp eq i32 %size.load, 0
@@ -318,19 +325,19 @@ if.end:                                           ; preds = %if.else, %if.then
   ret i32* %3
 }
 
-define void @_EN3std4ListI3intE13emptyListLastE(%"List<int>"* %this) {
+define weak_odr void @_EN3std4ListI3intE13emptyListLastE(%"List<int>"* %this) {
   %1 = call i32 (i8*, ...) @printf(i8* getelementptr inbounds ([29 x i8], [29 x i8]* @4, i32 0, i32 0))
   call void @_EN3std10fatalErrorE()
   ret void
 }
 
-define i32* @_EN3std4ListI3intE4dataE(%"List<int>"* %this) {
+define weak_odr i32* @_EN3std4ListI3intE4dataE(%"List<int>"* %this) {
   %buffer = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 0
   %buffer.load = load i32*, i32** %buffer
   ret i32* %buffer.load
 }
 
-define void @_EN3std4ListI3intE4growE(%"List<int>"* %this) {
+define weak_odr void @_EN3std4ListI3intE4growE(%"List<int>"* %this) {
   %capacity = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 2
   %capacity.load = load i32, i32* %capacity
   %1 = icmp eq i32 %capacity.load, 0
@@ -351,7 +358,7 @@ if.end:                                           ; preds = %if.else, %if.then
   ret void
 }
 
-define i32* @_EN3std13allocateArrayI3intEE4size3int(i32 %size) {
+define weak_odr i32* @_EN3std13allocateArrayI3intEE4size3int(i32 %size) {
   %1 = sext i32 %size to i64
   %2 = mul i64 ptrtoint (i32* getelementptr (i32, i32* null, i32 1) to i64), %1
   %3 = call i8* @malloc(i64 %2)
@@ -368,7 +375,7 @@ assert.success:                                   ; preds = %0
   ret i32* %5
 }
 
-define void @_EN3std4ListI3intE19resizeUninitializedE4size3int(%"List<int>"* %this, i32 %size) {
+define weak_odr void @_EN3std4ListI3intE19resizeUninitializedE4size3int(%"List<int>"* %this, i32 %size) {
   %size1 = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 1
   %size1.load = load i32, i32* %size1
   %1 = icmp eq i32 %size1.load, 0
@@ -403,7 +410,7 @@ declare i32 @puts(i8*)
 
 declare void @abort()
 
-define void @_EN3std4ListI3intE11removeFirstE(%"List<int>"* %this) {
+define weak_odr void @_EN3std4ListI3intE11removeFirstE(%"List<int>"* %this) {
   %size = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 1
   %size.load = load i32, i32* %size
   %1 = icmp eq i32 %size.load, 0
@@ -421,13 +428,13 @@ if.end:                                           ; preds = %if.else, %if.then
   ret void
 }
 
-define void @_EN3std4ListI3intE20emptyListRemoveFirstE(%"List<int>"* %this) {
+define weak_odr void @_EN3std4ListI3intE20emptyListRemoveFirstE(%"List<int>"* %this) {
   %1 = call i32 (i8*, ...) @printf(i8* getelementptr inbounds ([36 x i8], [36 x i8]* @5, i32 0, i32 0))
   call void @_EN3std10fatalErrorE()
   ret void
 }
 
-define void @_EN3std4ListI3intE14unsafeRemoveAtE5index3int(%"List<int>"* %this, i32 %index) {
+define weak_odr void @_EN3std4ListI3intE14unsafeRemoveAtE5index3int(%"List<int>"* %this, i32 %index) {
   %__iterator = alloca %"RangeIterator<int>"
   %1 = alloca %"Range<int>"
   %i = alloca i32
@@ -477,7 +484,7 @@ loop.end:                                         ; preds = %loop.condition
   ret void
 }
 
-define void @_EN3std4ListI3intE11removeFirstE12shouldRemoveFP3int_4bool(%"List<int>"* %this, i1 (i32*)* %shouldRemove) {
+define weak_odr void @_EN3std4ListI3intE11removeFirstE12shouldRemoveFP3int_4bool(%"List<int>"* %this, i1 (i32*)* %shouldRemove) {
   %__iterator = alloca %"RangeIterator<int>"
   %1 = alloca %"Range<int>"
   %index = alloca i32
@@ -519,7 +526,7 @@ if.end:                                           ; preds = %if.else
   br label %loop.increment
 }
 
-define void @_EN3std4ListI3intE10removeLastE(%"List<int>"* %this) {
+define weak_odr void @_EN3std4ListI3intE10removeLastE(%"List<int>"* %this) {
   %size = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 1
   %size.load = load i32, i32* %size
   %1 = icmp eq i32 %size.load, 0
@@ -540,13 +547,13 @@ if.end:                                           ; preds = %if.else, %if.then
   ret void
 }
 
-define void @_EN3std4ListI3intE19emptyListRemoveLastE(%"List<int>"* %this) {
+define weak_odr void @_EN3std4ListI3intE19emptyListRemoveLastE(%"List<int>"* %this) {
   %1 = call i32 (i8*, ...) @printf(i8* getelementptr inbounds ([35 x i8], [35 x i8]* @6, i32 0, i32 0))
   call void @_EN3std10fatalErrorE()
   ret void
 }
 
-define i32 @_EN3std4ListI3intE3popE(%"List<int>"* %this) {
+define weak_odr i32 @_EN3std4ListI3intE3popE(%"List<int>"* %this) {
   %size = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 1
   %size.load = load i32, i32* %size
   %1 = icmp eq i32 %size.load, 0
@@ -573,7 +580,7 @@ if.end:                                           ; preds = %if.else, %if.then
   ret i32 %.load
 }
 
-define void @_EN3std4ListI3intE8removeAtE5index3int(%"List<int>"* %this, i32 %index) {
+define weak_odr void @_EN3std4ListI3intE8removeAtE5index3int(%"List<int>"* %this, i32 %index) {
   %size = getelementptr inbounds %"List<int>", %"List<int>"* %this, i32 0, i32 1
   %size.load = load i32, i32* %size
   %1 = icmp sge i32 %index, %size.load
@@ -591,7 +598,7 @@ if.end:                                           ; preds = %if.else, %if.then
   ret void
 }
 
-define void @_EN3std13ArrayIteratorI3intE4initE5array8ArrayRefI3intE(%"ArrayIterator<int>"* %this, %"ArrayRef<int>" %array) {
+define weak_odr void @_EN3std13ArrayIteratorI3intE4initE5array8ArrayRefI3intE(%"ArrayIterator<int>"* %this, %"ArrayRef<int>" %array) {
   %1 = alloca %"ArrayRef<int>"
   %2 = alloca %"ArrayRef<int>"
   %3 = alloca %"ArrayRef<int>"
@@ -609,19 +616,19 @@ define void @_EN3std13ArrayIteratorI3intE4initE5array8ArrayRefI3intE(%"ArrayIter
   ret void
 }
 
-define i32* @_EN3std8ArrayRefI3intE4dataE(%"ArrayRef<int>"* %this) {
+define weak_odr i32* @_EN3std8ArrayRefI3intE4dataE(%"ArrayRef<int>"* %this) {
   %data = getelementptr inbounds %"ArrayRef<int>", %"ArrayRef<int>"* %this, i32 0, i32 0
   %data.load = load i32*, i32** %data
   ret i32* %data.load
 }
 
-define i32 @_EN3std8ArrayRefI3intE4sizeE(%"ArrayRef<int>"* %this) {
+define weak_odr i32 @_EN3std8ArrayRefI3intE4sizeE(%"ArrayRef<int>"* %this) {
   %size = getelementptr inbounds %"ArrayRef<int>", %"ArrayRef<int>"* %this, i32 0, i32 1
   %size.load = load i32, i32* %size
   ret i32 %size.load
 }
 
-define i1 @_EN3std13ArrayIteratorI3intE8hasValueE(%"ArrayIterator<int>"* %this) {
+define weak_odr i1 @_EN3std13ArrayIteratorI3intE8hasValueE(%"ArrayIterator<int>"* %this) {
   %current = getelementptr inbounds %"ArrayIterator<int>", %"ArrayIterator<int>"* %this, i32 0, i32 0
   %current.load = load i32*, i32** %current
   %end = getelementptr inbounds %"ArrayIterator<int>", %"ArrayIterator<int>"* %this, i32 0, i32 1
@@ -630,13 +637,13 @@ define i1 @_EN3std13ArrayIteratorI3intE8hasValueE(%"ArrayIterator<int>"* %this)
   ret i1 %1
 }
 
-define i32* @_EN3std13ArrayIteratorI3intE5valueE(%"ArrayIterator<int>"* %this) {
+define weak_odr i32* @_EN3std13ArrayIteratorI3intE5valueE(%"ArrayIterator<int>"* %this) {
   %current = getelementptr inbounds %"ArrayIterator<int>", %"ArrayIterator<int>"* %this, i32 0, i32 0
   %current.load = load i32*, i32** %current
   ret i32* %current.load
 }
 
-define void @_EN3std13ArrayIteratorI3intE9incrementE(%"ArrayIterator<int>"* %this) {
+define weak_odr void @_EN3std13ArrayIteratorI3intE9incrementE(%"ArrayIterator<int>"* %this) {
   %current = getelementptr inbounds %"ArrayIterator<int>", %"ArrayIterator<int>"* %this, i32 0, i32 0
   %current.load = load i32*, i32** %current
   %1 = getelementptr i32, i32* %current.load, i32 1
@@ -644,7 +651,7 @@ define void @_EN3std13ArrayIteratorI3intE9incrementE(%"ArrayIterator<int>"* %thi
   ret void
 }
 
-define %"ArrayIterator<int>" @_EN3std4ListI3intE8iteratorE(%"List<int>"* %this) {
+define weak_odr %"ArrayIterator<int>" @_EN3std4ListI3intE8iteratorE(%"List<int>"* %this) {
   %1 = alloca %"ArrayIterator<int>"
   %2 = alloca %"ArrayRef<int>"
   call void @_EN3std8ArrayRefI3intE4initE4listP4ListI3intE(%"ArrayRef<int>"* %2, %"List<int>"* %this)
@@ -654,7 +661,7 @@ define %"ArrayIterator<int>" @_EN3std4ListI3intE8iteratorE(%"List<int>"* %this)
   ret %"ArrayIterator<int>" %.load1
 }
 
-define void @_EN3std8ArrayRefI3intE4initE4listP4ListI3intE(%"ArrayRef<int>"* %this, %"List<int>"* %list) {
+define weak_odr void @_EN3std8ArrayRefI3intE4initE4listP4ListI3intE(%"ArrayRef<int>"* %this, %"List<int>"* %list) {
   %data = getelementptr inbounds %"ArrayRef<int>", %"ArrayRef<int>"* %this, i32 0, i32 0
   %1 = call i32* @_EN3std4ListI3intE4dataE(%"List<int>"* %list)
   store i32* %1, i32** %data
@@ -664,7 +671,7 @@ define void @_EN3std8ArrayRefI3intE4initE4listP4ListI3intE(%"ArrayRef<int>"* %th
   ret void
 }
 
-define void @_EN3std18EnumeratedIteratorI3intE4initE8iterator13ArrayIteratorI3intE(%"EnumeratedIterator<int>"* %this, %"ArrayIterator<int>" %iterator) {
+define weak_odr void @_EN3std18EnumeratedIteratorI3intE4initE8iterator13ArrayIteratorI3intE(%"EnumeratedIterator<int>"* %this, %"ArrayIterator<int>" %iterator) {
   %base = getelementptr inbounds %"EnumeratedIterator<int>", %"EnumeratedIterator<int>"* %this, i32 0, i32 0
   store %"ArrayIterator<int>" %iterator, %"ArrayIterator<int>"* %base
   %index = getelementptr inbounds %"EnumeratedIterator<int>", %"EnumeratedIterator<int>"* %this, i32 0, i32 1
@@ -672,13 +679,13 @@ define void @_EN3std18EnumeratedIteratorI3intE4initE8iterator13ArrayIteratorI3in
   ret void
 }
 
-define i1 @_EN3std18EnumeratedIteratorI3intE8hasValueE(%"EnumeratedIterator<int>"* %this) {
+define weak_odr i1 @_EN3std18EnumeratedIteratorI3intE8hasValueE(%"EnumeratedIterator<int>"* %this) {
   %base = getelementptr inbounds %"EnumeratedIterator<int>", %"EnumeratedIterator<int>"* %this, i32 0, i32 0
   %1 = call i1 @_EN3std13ArrayIteratorI3intE8hasValueE(%"ArrayIterator<int>"* %base)
   ret i1 %1
 }
 
-define void @_EN3std23EnumeratedIteratorEntryI3intE4initE5valueP3int5index3int(%"EnumeratedIteratorEntry<int>"* %this, i32* %value, i32 %index) {
+define weak_odr void @_EN3std23EnumeratedIteratorEntryI3intE4initE5valueP3int5index3int(%"EnumeratedIteratorEntry<int>"* %this, i32* %value, i32 %index) {
   %value1 = getelementptr inbounds %"EnumeratedIteratorEntry<int>", %"EnumeratedIteratorEntry<int>"* %this, i32 0, i32 0
   store i32* %value, i32** %value1
   %index2 = getelementptr inbounds %"EnumeratedIteratorEntry<int>", %"EnumeratedIteratorEntry<int>"* %this, i32 0, i32 1
@@ -686,7 +693,7 @@ define void @_EN3std23EnumeratedIteratorEntryI3intE4initE5valueP3int5index3int(%
   ret void
 }
 
-define %"EnumeratedIteratorEntry<int>" @_EN3std18EnumeratedIteratorI3intE5valueE(%"EnumeratedIterator<int>"* %this) {
+define weak_odr %"EnumeratedIteratorEntry<int>" @_EN3std18EnumeratedIteratorI3intE5valueE(%"EnumeratedIterator<int>"* %this) {
   %1 = alloca %"EnumeratedIteratorEntry<int>"
   %base = getelementptr inbounds %"EnumeratedIterator<int>", %"EnumeratedIterator<int>"* %this, i32 0, i32 0
   %2 = call i32* @_EN3std13ArrayIteratorI3intE5valueE(%"ArrayIterator<int>"* %base)
@@ -697,7 +704,7 @@ define %"EnumeratedIteratorEntry<int>" @_EN3std18EnumeratedIteratorI3intE5valueE
   ret %"EnumeratedIteratorEntry<int>" %.load
 }
 
-define void @_EN3std18EnumeratedIteratorI3intE9incrementE(%"EnumeratedIterator<int>"* %this) {
+define weak_odr void @_EN3std18EnumeratedIteratorI3intE9incrementE(%"EnumeratedIterator<int>"* %this) {
   %base = getelementptr inbounds %"EnumeratedIterator<int>", %"EnumeratedIterator<int>"* %this, i32 0, i32 0
   call void @_EN3std13ArrayIteratorI3intE9incrementE(%"ArrayIterator<int>"* %base)
   %index = getelementptr inbounds %"EnumeratedIterator<int>", %"EnumeratedIterator<int>"* %this, i32 0, i32 1
@@ -707,7 +714,7 @@ define void @_EN3std18EnumeratedIteratorI3intE9incrementE(%"EnumeratedIterator<i
   ret void
 }
 
-define %"EnumeratedIterator<int>" @_EN3std4ListI3intE9enumerateE(%"List<int>"* %this) {
+define weak_odr %"EnumeratedIterator<int>" @_EN3std4ListI3intE9enumerateE(%"List<int>"* %this) {
   %1 = alloca %"EnumeratedIterator<int>"
   %2 = call %"ArrayIterator<int>" @_EN3std4ListI3intE8iteratorE(%"List<int>"* %this)
   call void @_EN3std18EnumeratedIteratorI3intE4initE8iterator13ArrayIteratorI3intE(%"EnumeratedIterator<int>"* %1, %"ArrayIterator<int>" %2)
@@ -721,7 +728,7 @@ declare void @_EN3std10fatalErrorE()
 
 declare void @_EN3std8ArrayRefI3intE4initE4listP4ListI3intE.1(%"ArrayRef<int>"*, %"List<int>"*)
 
-define void @_EN3std8ArrayRefI3intE4initE4dataP3int4size3int(%"ArrayRef<int>"* %this, i32* %data, i32 %size) {
+define weak_odr void @_EN3std8ArrayRefI3intE4initE4dataP3int4size3int(%"ArrayRef<int>"* %this, i32* %data, i32 %size) {
   %data1 = getelementptr inbounds %"ArrayRef<int>", %"ArrayRef<int>"* %this, i32 0, i32 0
   store i32* %data, i32** %data1
   %size2 = getelementptr inbounds %"ArrayRef<int>", %"ArrayRef<int>"* %this, i32 0, i32 1
@@ -729,14 +736,14 @@ define void @_EN3std8ArrayRefI3intE4initE4dataP3int4size3int(%"ArrayRef<int>"* %
   ret void
 }
 
-define i32* @_EN3std8ArrayRefI3intEixE5index3int(%"ArrayRef<int>"* %this, i32 %index) {
+define weak_odr i32* @_EN3std8ArrayRefI3intEixE5index3int(%"ArrayRef<int>"* %this, i32 %index) {
   %data = getelementptr inbounds %"ArrayRef<int>", %"ArrayRef<int>"* %this, i32 0, i32 0
   %data.load = load i32*, i32** %data
   %1 = getelementptr i32, i32* %data.load, i32 %index
   ret i32* %1
 }
 
-define %"ArrayIterator<int>" @_EN3std8ArrayRefI3intE8iteratorE(%"ArrayRef<int>"* %this) {
+define weak_odr %"ArrayIterator<int>" @_EN3std8ArrayRefI3intE8iteratorE(%"ArrayRef<int>"* %this) {
   %1 = alloca %"ArrayIterator<int>"
   %this.load = load %"ArrayRef<int>", %"ArrayRef<int>"* %this
   call void @_EN3std13ArrayIteratorI3intE4initE5array8ArrayRefI3intE(%"ArrayIterator<int>"* %1, %"ArrayRef<int>" %this.load)
@@ -744,7 +751,7 @@ define %"ArrayIterator<int>" @_EN3std8ArrayRefI3intE8iteratorE(%"ArrayRef<int>"*
   ret %"ArrayIterator<int>" %.load
 }
 
-define void @_EN4main1MI3intE4initE1aPAR_3int({}* %this, %"ArrayRef<int>" %a) {
+define weak_odr void @_EN4main1MI3intE4initE1aPAR_3int({}* %this, %"ArrayRef<int>" %a) {
   ret void
 }
 
@@ -7,7 +7,7 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN26imported_generic_type_init1AI3intE4initE(%"A<int>"* %this) {
+define weak_odr void @_EN26imported_generic_type_init1AI3intE4initE(%"A<int>"* %this) {
   %a = getelementptr inbounds %"A<int>", %"A<int>"* %this, i32 0, i32 0
   store i32* null, i32** %a
   ret void
@@ -6,10 +6,10 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1AI3intE4initE({}* %this) {
+define weak_odr void @_EN4main1AI3intE4initE({}* %this) {
   ret void
 }
 
-define void @_EN4main1AI3intE1aE1n3int({}* %this, i32 %n) {
+define weak_odr void @_EN4main1AI3intE1aE1n3int({}* %this, i32 %n) {
   ret void
 }
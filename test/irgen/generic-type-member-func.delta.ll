@@ -8,14 +8,14 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1FI3int4boolE4initE(%"F<int, bool>"* %this) {
+define weak_odr void @_EN4main1FI3int4boolE4initE(%"F<int, bool>"* %this) {
   ret void
 }
 
-define void @_EN4main1FI3int4boolE3fooE(%"F<int, bool>"* %this) {
+define weak_odr void @_EN4main1FI3int4boolE3fooE(%"F<int, bool>"* %this) {
   ret void
 }
 
-define void @_EN4main1FI3int4boolE6unusedE(%"F<int, bool>"* %this) {
+define weak_odr void @_EN4main1FI3int4boolE6unusedE(%"F<int, bool>"* %this) {
   ret void
 }
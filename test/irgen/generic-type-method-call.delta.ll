@@ -6,14 +6,14 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1SI1AE4initE({}* %this) {
+define weak_odr void @_EN4main1SI1AE4initE({}* %this) {
   %1 = alloca {}
   call void @_EN4main1A4initE({}* %1)
   call void @_EN4main1A1hE({}* %1)
   ret void
 }
 
-define void @_EN4main1SI1AE1sE({}* %this) {
+define weak_odr void @_EN4main1SI1AE1sE({}* %this) {
   ret void
 }
 
@@ -9,28 +9,28 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1SI3intE1fE({}* %this) {
+define weak_odr void @_EN4main1SI3intE1fE({}* %this) {
   call void @_EN4main1SI3intE1gE({}* %this)
   ret void
 }
 
-define void @_EN4main1SI3intE4initE({}* %this) {
+define weak_odr void @_EN4main1SI3intE4initE({}* %this) {
   ret void
 }
 
-define void @_EN4main1SI5floatE1fE({}* %this) {
+define weak_odr void @_EN4main1SI5floatE1fE({}* %this) {
   call void @_EN4main1SI5floatE1gE({}* %this)
   ret void
 }
 
-define void @_EN4main1SI5floatE4initE({}* %this) {
+define weak_odr void @_EN4main1SI5floatE4initE({}* %this) {
   ret void
 }
 
-define void @_EN4main1SI3intE1gE({}* %this) {
+define weak_odr void @_EN4main1SI3intE1gE({}* %this) {
   ret void
 }
 
-define void @_EN4main1SI5floatE1gE({}* %this) {
+define weak_odr void @_EN4main1SI5floatE1gE({}* %this) {
   ret void
 }
@@ -5,16 +5,15 @@
 %"List<char>" = type { i8*, i32, i32 }
 
 @0 = private unnamed_addr constant [4 x i8] c"foo\00", align 1
+@__str0 = private unnamed_addr constant %StringRef { %"ArrayRef<char>" { i8* getelementptr inbounds ([4 x i8], [4 x i8]* @0, i32 0, i32 0), i32 3 } }
 @1 = private unnamed_addr constant [6 x i8] c"%.*s\0A\00", align 1
 
 define i32 @main() {
-  %__str0 = alloca %StringRef
-  call void @_EN3std9StringRef4initE7pointerP4char6length3int(%StringRef* %__str0, i8* getelementptr inbounds ([4 x i8], [4 x i8]* @0, i32 0, i32 0), i32 3)
-  call void @_EN3std5printI9StringRefEE5valueP9StringRef(%StringRef* %__str0)
+  call void @_EN3std5printI9StringRefEE5valueP9StringRef(%StringRef* @__str0)
   ret i32 0
 }
 
-define void @_EN3std5printI9StringRefEE5valueP9StringRef(%StringRef* %value) {
+define weak_odr void @_EN3std5printI9StringRefEE5valueP9StringRef(%StringRef* %value) {
   %string = alloca %String
   %1 = call %String @_EN3std9StringRef8toStringE(%StringRef* %value)
   store %String %1, %String* %string
@@ -25,8 +24,6 @@ define void @_EN3std5printI9StringRefEE5valueP9StringRef(%StringRef* %value) {
   ret void
 }
 
-declare void @_EN3std9StringRef4initE7pointerP4char6length3int(%StringRef*, i8*, i32)
-
 declare void @_EN3std6String6deinitE(%String*)
 
 declare %String @_EN3std9StringRef8toStringE(%StringRef*)
@@ -6,6 +6,6 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1fI3intEE1pP3int(i32* %p) {
+define weak_odr void @_EN4main1fI3intEE1pP3int(i32* %p) {
   ret void
 }
@@ -6,6 +6,6 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1fI4uintEE1a4uint1b4uint(i32 %a, i32 %b) {
+define weak_odr void @_EN4main1fI4uintEE1a4uint1b4uint(i32 %a, i32 %b) {
   ret void
 }
@@ -31,13 +31,13 @@ define void @_EN4main5Empty4initE({}* %this) {
   ret void
 }
 
-define void @_EN4main7GenericI7float64E4initE1i7float64(%"Generic<float64>"* %this, double %i) {
+define weak_odr void @_EN4main7GenericI7float64E4initE1i7float64(%"Generic<float64>"* %this, double %i) {
   %i1 = getelementptr inbounds %"Generic<float64>", %"Generic<float64>"* %this, i32 0, i32 0
   store double %i, double* %i1
   ret void
 }
 
-define void @_EN4main7GenericI3intE4initE1i3int(%"Generic<int>"* %this, i32 %i) {
+define weak_odr void @_EN4main7GenericI3intE4initE1i3int(%"Generic<int>"* %this, i32 %i) {
   %i1 = getelementptr inbounds %"Generic<int>", %"Generic<int>"* %this, i32 0, i32 0
   store i32 %i, i32* %i1
   ret void
@@ -27,7 +27,7 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1fI1SEE1aP1S(%S* %a) {
+define weak_odr void @_EN4main1fI1SEE1aP1S(%S* %a) {
   %1 = call %S* @_EN4main1S3fooE1aP1S(%S* %a, %S* %a)
   %2 = call %S* @_EN4main1S3fooE1aP1S(%S* %a, %S* %1)
   ret void
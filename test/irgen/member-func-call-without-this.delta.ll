@@ -19,17 +19,17 @@ define void @_EN4main1S3fooE({}* %this) {
   ret void
 }
 
-define void @_EN4main3FooI3intE6deinitE({}* %this) {
+define weak_odr void @_EN4main3FooI3intE6deinitE({}* %this) {
   call void @_EN4main3FooI3intE3bazE({}* %this)
   ret void
 }
 
-define void @_EN4main3FooI3intE4initE({}* %this) {
+define weak_odr void @_EN4main3FooI3intE4initE({}* %this) {
   call void @_EN4main3FooI3intE3bazE({}* %this)
   ret void
 }
 
-define void @_EN4main3FooI3intE3bazE({}* %this) {
+define weak_odr void @_EN4main3FooI3intE3bazE({}* %this) {
   call void @_EN4main3FooI3intE3quxE({}* %this)
   ret void
 }
@@ -38,6 +38,6 @@ define void @_EN4main1S3barE({}* %this) {
   ret void
 }
 
-define void @_EN4main3FooI3intE3quxE({}* %this) {
+define weak_odr void @_EN4main3FooI3intE3quxE({}* %this) {
   ret void
 }
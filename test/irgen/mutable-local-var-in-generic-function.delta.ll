@@ -4,7 +4,7 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1fI3intEE() {
+define weak_odr void @_EN4main1fI3intEE() {
   %i = alloca i32
   store i32 0, i32* %i
   %i.load = load i32, i32* %i
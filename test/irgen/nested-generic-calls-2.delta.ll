@@ -17,11 +17,11 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1MI1SE4initE(%"M<S>"* %this) {
+define weak_odr void @_EN4main1MI1SE4initE(%"M<S>"* %this) {
   ret void
 }
 
-define void @_EN4main1MI1SE1fE(%"M<S>"* %this) {
+define weak_odr void @_EN4main1MI1SE1fE(%"M<S>"* %this) {
   %a = alloca {}
   %1 = alloca %S
   call void @_EN4main1AI1SE4initE({}* %a)
@@ -31,11 +31,11 @@ define void @_EN4main1MI1SE1fE(%"M<S>"* %this) {
   ret void
 }
 
-define void @_EN4main1AI1SE4initE({}* %this) {
+define weak_odr void @_EN4main1AI1SE4initE({}* %this) {
   ret void
 }
 
-define %S @_EN4main1AI1SE1aE({}* %this) {
+define weak_odr %S @_EN4main1AI1SE1aE({}* %this) {
   %1 = alloca %S
   call void @_EN4main1S4initE(%S* %1)
   %.load = load %S, %S* %1
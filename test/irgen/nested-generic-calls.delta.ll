@@ -5,20 +5,20 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN4main1gI3intEE1t3int(i32 %t) {
+define weak_odr void @_EN4main1gI3intEE1t3int(i32 %t) {
   call void @_EN4main1fI3intEE1t3int(i32 %t)
   ret void
 }
 
-define void @_EN4main1gI4boolEE1t4bool(i1 %t) {
+define weak_odr void @_EN4main1gI4boolEE1t4bool(i1 %t) {
   call void @_EN4main1fI4boolEE1t4bool(i1 %t)
   ret void
 }
 
-define void @_EN4main1fI3intEE1t3int(i32 %t) {
+define weak_odr void @_EN4main1fI3intEE1t3int(i32 %t) {
   ret void
 }
 
-define void @_EN4main1fI4boolEE1t4bool(i1 %t) {
+define weak_odr void @_EN4main1fI4boolEE1t4bool(i1 %t) {
   ret void
 }
@@ -0,0 +1,27 @@
+
+%Foo = type { i32, i1 }
+
+declare void @f(i32*) #0
+
+define void @_EN4main3Foo4initE(%Foo* nonnull dereferenceable(8) %this) #0 {
+  %a = getelementptr inbounds %Foo, %Foo* %this, i32 0, i32 0
+  store i32 42, i32* %a, !tbaa !0
+  %b = getelementptr inbounds %Foo, %Foo* %this, i32 0, i32 1
+  store i1 true, i1* %b, !tbaa !4
+  ret void
+}
+
+define i32 @_EN4main3Foo3getE1pP3int(%Foo* nonnull dereferenceable(8) %this, i32* nonnull %p) #0 {
+  call void @f(i32* %p)
+  %a = getelementptr inbounds %Foo, %Foo* %this, i32 0, i32 0
+  %a.load = load i32, i32* %a, !tbaa !0
+  ret i32 %a.load
+}
+
+attributes #0 = { nounwind }
+
+!0 = !{!1, !1, i64 0}
+!1 = !{!"int32", !2, i64 0}
+!2 = !{!"omnipotent char", !3, i64 0}
+!3 = !{!"Delta TBAA"}
+!4 = !{!2, !2, i64 0}
@@ -0,0 +1,13 @@
+define i32 @main() {
+  call void @_EN4main3fooE()
+  call void @_EN4main3barE()
+  ret i32 0
+}
+
+define internal void @_EN4main3fooE() {
+  ret void
+}
+
+define void @_EN4main3barE() {
+  ret void
+}
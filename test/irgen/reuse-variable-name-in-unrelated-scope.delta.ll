@@ -18,12 +18,12 @@ define {} @_EN4main1gE() {
   ret {} %x.load
 }
 
-define void @_EN4main1XI3intE1gE({}* %this) {
+define weak_odr void @_EN4main1XI3intE1gE({}* %this) {
   %index = alloca i32
   store i32 0, i32* %index
   ret void
 }
 
-define void @_EN4main1XI3intE4initE({}* %this) {
+define weak_odr void @_EN4main1XI3intE4initE({}* %this) {
   ret void
 }
@@ -3,14 +3,11 @@
 %"ArrayRef<char>" = type { i8*, i32 }
 
 @0 = private unnamed_addr constant [4 x i8] c"foo\00", align 1
+@__str0 = private unnamed_addr constant %StringRef { %"ArrayRef<char>" { i8* getelementptr inbounds ([4 x i8], [4 x i8]* @0, i32 0, i32 0), i32 3 } }
 
 define i32 @main() {
   %s = alloca %StringRef
-  %__str0 = alloca %StringRef
-  call void @_EN3std9StringRef4initE7pointerP4char6length3int(%StringRef* %__str0, i8* getelementptr inbounds ([4 x i8], [4 x i8]* @0, i32 0, i32 0), i32 3)
-  %__str0.load = load %StringRef, %StringRef* %__str0
+  %__str0.load = load %StringRef, %StringRef* @__str0
   store %StringRef %__str0.load, %StringRef* %s
   ret i32 0
 }
-
-declare void @_EN3std9StringRef4initE7pointerP4char6length3int(%StringRef*, i8*, i32)
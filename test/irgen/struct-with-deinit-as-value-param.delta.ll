@@ -1,11 +1,11 @@
 
 %"A<int>" = type { i32 }
 
-define void @_EN4main1AI3intE6deinitE(%"A<int>"* %this) {
+define weak_odr void @_EN4main1AI3intE6deinitE(%"A<int>"* %this) {
   ret void
 }
 
-define void @_EN4main1AI3intE4initE1i3int(%"A<int>"* %this, i32 %i) {
+define weak_odr void @_EN4main1AI3intE4initE1i3int(%"A<int>"* %this, i32 %i) {
   %i1 = getelementptr inbounds %"A<int>", %"A<int>"* %this, i32 0, i32 0
   store i32 %i, i32* %i1
   ret void
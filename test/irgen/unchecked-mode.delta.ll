@@ -0,0 +1,11 @@
+declare i1 @b()
+
+declare i8* @f()
+
+define i32 @main() {
+  %byte = alloca i8*
+  %1 = call i1 @b()
+  %2 = call i8* @f()
+  store i8* %2, i8** %byte
+  ret i32 0
+}
@@ -26,14 +26,14 @@ define i32 @main() {
   ret i32 0
 }
 
-define void @_EN3std9UniquePtrI3intE4initE5value3int(%"UniquePtr<int>"* %this, i32 %value) {
+define weak_odr void @_EN3std9UniquePtrI3intE4initE5value3int(%"UniquePtr<int>"* %this, i32 %value) {
   %pointer = getelementptr inbounds %"UniquePtr<int>", %"UniquePtr<int>"* %this, i32 0, i32 0
   %1 = call i32* @_EN3std8allocateI3intEE5value3int(i32 %value)
   store i32* %1, i32** %pointer
   ret void
 }
 
-define i32* @_EN3std8allocateI3intEE5value3int(i32 %value) {
+define weak_odr i32* @_EN3std8allocateI3intEE5value3int(i32 %value) {
   %allocation = alloca i32*
   %1 = call i8* @malloc(i64 ptrtoint (i32* getelementptr (i32, i32* null, i32 1) to i64))
   %assert.condition = icmp eq i8* %1, null
@@ -53,39 +53,39 @@ assert.success:                                   ; preds = %0
   ret i32* %allocation.load1
 }
 
-define void @_EN3std9UniquePtrI3intE4initE7pointerP3int(%"UniquePtr<int>"* %this, i32* %pointer) {
+define weak_odr void @_EN3std9UniquePtrI3intE4initE7pointerP3int(%"UniquePtr<int>"* %this, i32* %pointer) {
   %pointer1 = getelementptr inbounds %"UniquePtr<int>", %"UniquePtr<int>"* %this, i32 0, i32 0
   store i32* %pointer, i32** %pointer1
   ret void
 }
 
-define void @_EN3std9UniquePtrI3intE6deinitE(%"UniquePtr<int>"* %this) {
+define weak_odr void @_EN3std9UniquePtrI3intE6deinitE(%"UniquePtr<int>"* %this) {
   %pointer = getelementptr inbounds %"UniquePtr<int>", %"UniquePtr<int>"* %this, i32 0, i32 0
   %pointer.load = load i32*, i32** %pointer
   call void @_EN3std10deallocateI3intEE10allocationP3int(i32* %pointer.load)
   ret void
 }
 
-define void @_EN3std10deallocateI3intEE10allocationP3int(i32* %allocation) {
+define weak_odr void @_EN3std10deallocateI3intEE10allocationP3int(i32* %allocation) {
   %1 = bitcast i32* %allocation to i8*
   call void @free(i8* %1)
   ret void
 }
 
-define i32* @_EN3std9UniquePtrI3intE3getE(%"UniquePtr<int>"* %this) {
+define weak_odr i32* @_EN3std9UniquePtrI3intE3getE(%"UniquePtr<int>"* %this) {
   %pointer = getelementptr inbounds %"UniquePtr<int>", %"UniquePtr<int>"* %this, i32 0, i32 0
   %pointer.load = load i32*, i32** %pointer
   ret i32* %pointer.load
 }
 
-define void @_EN3std9UniquePtrI9UniquePtrI3intEE4initE5value9UniquePtrI3intE(%"UniquePtr<UniquePtr<int>>"* %this, %"UniquePtr<int>" %value) {
+define weak_odr void @_EN3std9UniquePtrI9UniquePtrI3intEE4initE5value9UniquePtrI3intE(%"UniquePtr<UniquePtr<int>>"* %this, %"UniquePtr<int>" %value) {
   %pointer = getelementptr inbounds %"UniquePtr<UniquePtr<int>>", %"UniquePtr<UniquePtr<int>>"* %this, i32 0, i32 0
   %1 = call %"UniquePtr<int>"* @_EN3std8allocateI9UniquePtrI3intEEE5value9UniquePtrI3intE(%"UniquePtr<int>" %value)
   store %"UniquePtr<int>"* %1, %"UniquePtr<int>"** %pointer
   ret void
 }
 
-define %"UniquePtr<int>"* @_EN3std8allocateI9UniquePtrI3intEEE5value9UniquePtrI3intE(%"UniquePtr<int>" %value) {
+define weak_odr %"UniquePtr<int>"* @_EN3std8allocateI9UniquePtrI3intEEE5value9UniquePtrI3intE(%"UniquePtr<int>" %value) {
   %allocation = alloca %"UniquePtr<int>"*
   %1 = call i8* @malloc(i64 ptrtoint (i1** getelementptr (i1*, i1** null, i32 1) to i64))
   %assert.condition = icmp eq i8* %1, null
@@ -105,26 +105,26 @@ assert.success:                                   ; preds = %0
   ret %"UniquePtr<int>"* %allocation.load1
 }
 
-define void @_EN3std9UniquePtrI9UniquePtrI3intEE4initE7pointerP9UniquePtrI3intE(%"UniquePtr<UniquePtr<int>>"* %this, %"UniquePtr<int>"* %pointer) {
+define weak_odr void @_EN3std9UniquePtrI9UniquePtrI3intEE4initE7pointerP9UniquePtrI3intE(%"UniquePtr<UniquePtr<int>>"* %this, %"UniquePtr<int>"* %pointer) {
   %pointer1 = getelementptr inbounds %"UniquePtr<UniquePtr<int>>", %"UniquePtr<UniquePtr<int>>"* %this, i32 0, i32 0
   store %"UniquePtr<int>"* %pointer, %"UniquePtr<int>"** %pointer1
   ret void
 }
 
-define void @_EN3std9UniquePtrI9UniquePtrI3intEE6deinitE(%"UniquePtr<UniquePtr<int>>"* %this) {
+define weak_odr void @_EN3std9UniquePtrI9UniquePtrI3intEE6deinitE(%"UniquePtr<UniquePtr<int>>"* %this) {
   %pointer = getelementptr inbounds %"UniquePtr<UniquePtr<int>>", %"UniquePtr<UniquePtr<int>>"* %this, i32 0, i32 0
   %pointer.load = load %"UniquePtr<int>"*, %"UniquePtr<int>"** %pointer
   call void @_EN3std10deallocateI9UniquePtrI3intEEE10allocationP9UniquePtrI3intE(%"UniquePtr<int>"* %pointer.load)
   ret void
 }
 
-define void @_EN3std10deallocateI9UniquePtrI3intEEE10allocationP9UniquePtrI3intE(%"UniquePtr<int>"* %allocation) {
+define weak_odr void @_EN3std10deallocateI9UniquePtrI3intEEE10allocationP9UniquePtrI3intE(%"UniquePtr<int>"* %allocation) {
   %1 = bitcast %"UniquePtr<int>"* %allocation to i8*
   call void @free(i8* %1)
   ret void
 }
 
-define %"UniquePtr<int>"* @_EN3std9UniquePtrI9UniquePtrI3intEE3getE(%"UniquePtr<UniquePtr<int>>"* %this) {
+define weak_odr %"UniquePtr<int>"* @_EN3std9UniquePtrI9UniquePtrI3intEE3getE(%"UniquePtr<UniquePtr<int>>"* %this) {
   %pointer = getelementptr inbounds %"UniquePtr<UniquePtr<int>>", %"UniquePtr<UniquePtr<int>>"* %this, i32 0, i32 0
   %pointer.load = load %"UniquePtr<int>"*, %"UniquePtr<int>"** %pointer
   ret %"UniquePtr<int>"* %pointer.load
@@ -0,0 +1,16 @@
+#!/usr/bin/env python
+
+# Prints a Delta program that instantiates the given number of distinct generic types.
+
+import sys
+
+count = int(sys.argv[1])
+functions_per_line = 10
+
+print("struct Box<T> { T value; }")
+
+for line_start in range(0, count, functions_per_line):
+    functions = []
+    for i in range(line_start, min(line_start + functions_per_line, count)):
+        functions.append("void f{0}(Box<int[{1}]>*? p) {{}}".format(i, i + 1))
+    print(" ".join(functions))